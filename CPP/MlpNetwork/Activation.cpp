@@ -13,7 +13,10 @@
 // ------------------------------ includes ------------------------------
 
 #include "Activation.h"
+#include "SimdKernels.h"
 #include <cmath>
+#include <vector>
+#include <utility>
 
 // ------------------------------ constructors -----------------------------
 
@@ -29,51 +32,107 @@ Activation::Activation(ActivationType actType) : activationType(actType)
 // ------------------------------ private functions - not part of the API -----------------------------
 
 /**
- * Relu function to activate on given vector
- * @param vectorToReturn reference to given vector to activate Relu function on return reference to it after
- * activation was made.
- * @return  reference to given vector after Relu function was activated on it
+ * Relu function to activate in place on given values
+ * @param values values to activate Relu function on
+ * @param size number of values
  */
-Matrix &relu(Matrix &vectorToReturn)
+void relu(float *values, const long size)
 {
-    if (vectorToReturn.getCols() != 1)
+    simdKernels().relu(values, values, size);
+}
+
+/**
+ * Softmax (or LogSoftmax) function to activate in place on every column of a given batch of vectors (each column is a
+ * different vector). every column's max is subtracted before the exponents are taken, so no exponent overflows.
+ * @param values batch's values, stored row after row
+ * @param rows batch's number of rows (size of each vector)
+ * @param cols batch's number of columns (number of vectors)
+ * @param logarithm whether to write the log of the probabilities
+ */
+void batchSoftmax(float *values, const int rows, const int cols, const bool logarithm)
+{
+    const SimdKernelTable &kernels = simdKernels();
+    std::vector<float> colMax(values, values + cols);
+    for (int i = 1; i < rows; i++)
     {
-        std::cerr << "Error: Relu function can only be applied on vectors" << std::endl;
-        exit(1);
+        const float *row = values + (long) i * cols;
+        for (int j = 0; j < cols; j++)
+        {
+            colMax[j] = row[j] > colMax[j] ? row[j] : colMax[j];
+        }
     }
-    for (int i = 0; i < vectorToReturn.getRows(); i++)
+    std::vector<float> eSums(cols, 0.0f), shifted(cols);
+    for (int i = 0; i < rows; i++)
     {
-        if (vectorToReturn[i] < 0)
+        float *row = values + (long) i * cols;
+        for (int j = 0; j < cols; j++)
         {
-            vectorToReturn[i] = 0;
+            shifted[j] = row[j] - colMax[j];
+        }
+        float *exponents = logarithm ? shifted.data() : row;
+        kernels.expSum(shifted.data(), 0, exponents, cols);
+        kernels.axpy(1.0f, exponents, eSums.data(), cols);
+    }
+    for (int j = 0; j < cols; j++)
+    {
+        eSums[j] = logarithm ? colMax[j] + std::log(eSums[j]) : 1 / eSums[j];
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        float *row = values + (long) i * cols;
+        for (int j = 0; j < cols; j++)
+        {
+            row[j] = logarithm ? row[j] - eSums[j] : row[j] * eSums[j];
         }
     }
-    return vectorToReturn;
 }
 
 /**
- * Softmax function to activate on given vector
- * @param vectorToReturn reference to given vector to activate Softmax function on return reference to it after
- * activation was made.
- * @return  reference to given vector after Softmax function was activated on it
+ * Softmax function to activate in place on given vector (or on every column of a given batch of vectors): one pass
+ * finds the max, one pass writes exp(value - max) and sums it, and one pass multiplies by the sum's inverse.
+ * @param values vector's values, stored row after row
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
  */
-Matrix &softmax(Matrix &vectorToReturn)
+void softmax(float *values, const int rows, const int cols)
 {
-    if (vectorToReturn.getCols() != 1)
+    if (cols != 1)
     {
-        std::cerr << "Error: Softmax function can only be applied on vectors" << std::endl;
-        exit(1);
+        batchSoftmax(values, rows, cols, false);
+        return;
     }
-    float eSum = 0;
-    for (int i = 0; i < vectorToReturn.getRows(); i++)
+    const SimdKernelTable &kernels = simdKernels();
+    const float maxValue = kernels.max(values, rows);
+    const float eSum = kernels.expSum(values, maxValue, values, rows);
+    kernels.scale(values, 1 / eSum, values, rows);
+}
+
+/**
+ * LogSoftmax function to activate in place on given vector (or on every column of a given batch of vectors):
+ * value - (max + log(sum(exp(value - max)))).
+ * @param values vector's values, stored row after row
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
+ */
+void logSoftmax(float *values, const int rows, const int cols)
+{
+    if (cols != 1)
     {
-        eSum += std::exp(vectorToReturn[i]);
+        batchSoftmax(values, rows, cols, true);
+        return;
     }
-    for (int i = 0; i < vectorToReturn.getRows(); i++)
+    static thread_local std::vector<float> exponents;
+    if ((int) exponents.size() < rows)
     {
-        vectorToReturn[i] = (1 / eSum) * std::exp(vectorToReturn[i]);
+        exponents.resize(rows);
+    }
+    const SimdKernelTable &kernels = simdKernels();
+    const float maxValue = kernels.max(values, rows);
+    const float logSum = maxValue + std::log(kernels.expSum(values, maxValue, exponents.data(), rows));
+    for (int i = 0; i < rows; i++)
+    {
+        values[i] -= logSum;
     }
-    return vectorToReturn;
 }
 
 // ------------------------------ public functions - part of the API -----------------------------
@@ -82,7 +141,7 @@ Matrix &softmax(Matrix &vectorToReturn)
  * getter for this Activation ActivationType
  * @return this Activation ActivationType
  */
-ActivationType Activation::getActivationType()
+ActivationType Activation::getActivationType() const
 {
     return this->activationType;
 }
@@ -96,14 +155,143 @@ ActivationType Activation::getActivationType()
  */
 Matrix Activation::operator()(const Matrix &m) const
 {
-    Matrix vectorToReturn(m);
+    return (*this)(Matrix(m));
+}
+
+/**
+ * overloading operator "()" for Activation object and a temporary Matrix: the ActivationType function is activated
+ * in place on the temporary's buffer, which is then moved to the returned Matrix (no copy is made). on a padded
+ * matrix Relu is activated row by row, and the Softmax functions (which work on columns) on a packed copy.
+ * @param m given temporary matrix
+ * @return Matrix made form given Matrix after it's ActivationType function was activated on it.
+ */
+Matrix Activation::operator()(Matrix &&m) const
+{
+    if (m.getLeadingDim() != m.getCols())
+    {
+        if (this->activationType == Softmax || this->activationType == LogSoftmax)
+        {
+            return (*this)(Matrix(m, PackedRows));
+        }
+        for (int i = 0; i < m.getRows(); i++)
+        {
+            this->applyInPlace(m.getData() + (long) i * m.getLeadingDim(), 1, m.getCols());
+        }
+        return std::move(m);
+    }
+    this->applyInPlace(m.getData(), m.getRows(), m.getCols());
+    return std::move(m);
+}
+
+/**
+ * overloading operator "()" for Activation object and a view: the viewed values are read once into the returned
+ * Matrix, and the ActivationType function is activated on it in place.
+ * @param m given view
+ * @return new Matrix made from the viewed values after the ActivationType function was activated on them.
+ */
+Matrix Activation::operator()(const MatrixView &m) const
+{
+    return (*this)(Matrix(m));
+}
+
+/**
+ * activates this Activation's ActivationType function in place on a given buffer holding a vector (or a batch of
+ * vectors, one per column).
+ * @param values values to activate the function on, stored row after row
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
+ */
+void Activation::applyInPlace(float *values, const int rows, const int cols) const
+{
+    if (this->activationType == Relu)
+    {
+        relu(values, (long) rows * cols);
+    }
+    else if (this->activationType == Softmax)
+    {
+        softmax(values, rows, cols);
+    }
+    else if (this->activationType == LogSoftmax)
+    {
+        logSoftmax(values, rows, cols);
+    }
+}
+
+/**
+ * backward pass of this Activation's ActivationType function, in place: turns the gradient of the loss with
+ * respect to the function's outputs into the gradient with respect to it's inputs. for Softmax that is
+ * y * (g - sum(g * y)) and for LogSoftmax g - exp(y) * sum(g), per column.
+ * @param outputs the function's outputs (as written by applyInPlace()), stored row after row
+ * @param gradients gradient with respect to the outputs, replaced by the gradient with respect to the inputs
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
+ */
+void Activation::backwardInPlace(const float *outputs, float *gradients, const int rows, const int cols) const
+{
+    const long size = (long) rows * cols;
     if (this->activationType == Relu)
     {
-        return relu(vectorToReturn);
+        for (long i = 0; i < size; i++)
+        {
+            gradients[i] = outputs[i] > 0 ? gradients[i] : 0;
+        }
+        return;
+    }
+    if (this->activationType == Identity)
+    {
+        return;
+    }
+    std::vector<float> colSums(cols, 0.0f);
+    for (long i = 0; i < size; i++)
+    {
+        colSums[i % cols] += this->activationType == Softmax ? gradients[i] * outputs[i] : gradients[i];
+    }
+    for (long i = 0; i < size; i++)
+    {
+        gradients[i] = this->activationType == Softmax ? outputs[i] * (gradients[i] - colSums[i % cols]) :
+                       gradients[i] - std::exp(outputs[i]) * colSums[i % cols];
+    }
+}
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * softmax followed by the cross-entropy loss, fused for training: the gradient of the loss with respect to the
+ * logits is simply softmax(logits) - onehot(label). the loss is read from the log-softmax, so it stays finite for
+ * very confident predictions.
+ * @param values logits of a batch of vectors (each column is a vector), stored row after row. replaced by the
+ * gradient of the loss with respect to them.
+ * @param labels label (index of the expected row) of every column
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
+ * @param correct output, number of columns whose largest logit is the label's
+ * @return sum of the columns' cross-entropy losses
+ */
+float softmaxCrossEntropy(float *values, const int *labels, const int rows, const int cols, int &correct)
+{
+    batchSoftmax(values, rows, cols, true);
+    float loss = 0;
+    correct = 0;
+    for (int j = 0; j < cols; j++)
+    {
+        const float labelLogProb = values[(long) labels[j] * cols + j];
+        loss -= labelLogProb;
+        bool isMax = true;
+        for (int i = 0; i < rows && isMax; i++)
+        {
+            isMax = values[(long) i * cols + j] <= labelLogProb;
+        }
+        correct += isMax;
+    }
+    const SimdKernelTable &kernels = simdKernels();
+    for (int i = 0; i < rows; i++)
+    {
+        kernels.expSum(values + (long) i * cols, 0, values + (long) i * cols, cols);
     }
-    else
+    for (int j = 0; j < cols; j++)
     {
-        return softmax(vectorToReturn);
+        values[(long) labels[j] * cols + j] -= 1;
     }
+    return loss;
 }
 
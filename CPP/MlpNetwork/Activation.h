@@ -14,12 +14,15 @@
 
 /**
  * @enum ActivationType
- * @brief Indicator of activation function.
+ * @brief Indicator of activation function. Identity leaves the values as they are (a layer without activation),
+ * LogSoftmax gives the log of Softmax's probabilities (computed directly, so it stays finite for tiny probabilities).
  */
 enum ActivationType
 {
     Relu,
-    Softmax
+    Softmax,
+    Identity,
+    LogSoftmax
 };
 
 /**
@@ -41,16 +44,65 @@ public:
      * getter for this Activation ActivationType
      * @return this Activation ActivationType
      */
-    ActivationType getActivationType();
+    ActivationType getActivationType() const;
 
     /**
      * overloading operator "()" for Activation object: returns a new Matrix (actually a vector) made form given Matrix
-     * after it's ActivationType function was activated on it.
+     * after it's ActivationType function was activated on it. when the given matrix has more than one column, each
+     * column is treated as a different vector (softmax is computed per column).
      * @param m given matrix
      * @return new Matrix (actually a vector) made form given Matrix
      * after it's ActivationType function was activated on it.
      */
     Matrix operator()(const Matrix &m) const;
+
+    /**
+     * overloading operator "()" for Activation object and a temporary Matrix: the ActivationType function is activated
+     * in place on the temporary's buffer, which is then moved to the returned Matrix (no copy is made).
+     * @param m given temporary matrix
+     * @return Matrix made form given Matrix after it's ActivationType function was activated on it.
+     */
+    Matrix operator()(Matrix &&m) const;
+
+    /**
+     * overloading operator "()" for Activation object and a view (see MatrixView.h): the viewed values are read once
+     * into the returned Matrix, and the ActivationType function is activated on it in place.
+     * @param m given view
+     * @return new Matrix made from the viewed values after the ActivationType function was activated on them.
+     */
+    Matrix operator()(const MatrixView &m) const;
+
+    /**
+     * activates this Activation's ActivationType function in place on a given buffer holding a vector (or a batch of
+     * vectors, one per column).
+     * @param values values to activate the function on, stored row after row
+     * @param rows number of rows (size of each vector)
+     * @param cols number of columns (number of vectors)
+     */
+    void applyInPlace(float *values, int rows, int cols) const;
+
+    /**
+     * backward pass of this Activation's ActivationType function, in place: turns the gradient of the loss with
+     * respect to the function's outputs into the gradient with respect to it's inputs.
+     * @param outputs the function's outputs (as written by applyInPlace()), stored row after row
+     * @param gradients gradient with respect to the outputs, replaced by the gradient with respect to the inputs
+     * @param rows number of rows (size of each vector)
+     * @param cols number of columns (number of vectors)
+     */
+    void backwardInPlace(const float *outputs, float *gradients, int rows, int cols) const;
 };
 
+/**
+ * softmax followed by the cross-entropy loss, fused for training: the gradient of the loss with respect to the
+ * logits is simply softmax(logits) - onehot(label), which is also stable for very confident predictions.
+ * @param values logits of a batch of vectors (each column is a vector), stored row after row. replaced by the
+ * gradient of the loss with respect to them.
+ * @param labels label (index of the expected row) of every column
+ * @param rows number of rows (size of each vector)
+ * @param cols number of columns (number of vectors)
+ * @param correct output, number of columns whose largest logit is the label's
+ * @return sum of the columns' cross-entropy losses
+ */
+float softmaxCrossEntropy(float *values, const int *labels, int rows, int cols, int &correct);
+
 #endif //ACTIVATION_H
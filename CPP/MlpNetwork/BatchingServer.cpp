@@ -0,0 +1,341 @@
+/**
+ * @file BatchingServer.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief BatchingServer object class - long-running inference server that groups concurrent requests into batches.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "BatchingServer.h"
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def SOCKET_BACKLOG
+ * @brief number of connections the socket queues before they are accepted
+ */
+#define SOCKET_BACKLOG 64
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * reads exactly size bytes from a file descriptor, retrying on short reads and interrupts
+ * @param fd file descriptor to read from
+ * @param buffer destination buffer
+ * @param size number of bytes to read
+ * @return true if all the bytes were read, false on end of input or error
+ */
+static bool readFully(const int fd, void *buffer, size_t size)
+{
+    char *bytes = (char *) buffer;
+    while (size > 0)
+    {
+        const ssize_t count = read(fd, bytes, size);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        bytes += count;
+        size -= (size_t) count;
+    }
+    return true;
+}
+
+/**
+ * writes exactly size bytes to a file descriptor, retrying on short writes and interrupts
+ * @param fd file descriptor to write to
+ * @param buffer source buffer
+ * @param size number of bytes to write
+ * @return true if all the bytes were written, false on error (e.g. the peer closed the connection)
+ */
+static bool writeFully(const int fd, const void *buffer, size_t size)
+{
+    const char *bytes = (const char *) buffer;
+    while (size > 0)
+    {
+        const ssize_t count = write(fd, bytes, size);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        bytes += count;
+        size -= (size_t) count;
+    }
+    return true;
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for BatchingServer object: starts the batcher thread. exits with an error message if the
+ * configuration is invalid.
+ * @param classifier classifier to run the batches on (must outlive the server)
+ * @param imageSize number of floats in an image (the classifier's input size)
+ * @param config when batches are run
+ */
+BatchingServer::BatchingServer(const DigitClassifier &classifier, const int imageSize, const BatchingConfig &config) :
+        classifier(classifier), imageSize(imageSize), config(config), stopping(false), servedRequests(0),
+        servedBatches(0)
+{
+    if (imageSize <= 0 || config.maxBatchSize <= 0 || config.maxDelayMicros < 0)
+    {
+        std::cerr << "Error: invalid batching server configuration" << std::endl;
+        exit(1);
+    }
+    batcher = std::thread(&BatchingServer::batchLoop, this);
+}
+
+/**
+ * destructor for BatchingServer object: classifies the requests still queued and joins the batcher thread
+ */
+BatchingServer::~BatchingServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    requestArrived.notify_all();
+    batcher.join();
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * main loop of the batcher thread: waits for the first request of a batch, then until the batch is full or it's
+ * oldest request's deadline, and classifies up to maxBatchSize requests outside the lock so new requests queue up
+ * for the next batch meanwhile.
+ */
+void BatchingServer::batchLoop()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true)
+    {
+        requestArrived.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty())
+        {
+            return;
+        }
+        const auto deadline = pending.front().arrival + std::chrono::microseconds(config.maxDelayMicros);
+        requestArrived.wait_until(lock, deadline, [this]
+        {
+            return stopping || (int) pending.size() >= config.maxBatchSize;
+        });
+        const size_t batchSize = std::min(pending.size(), (size_t) config.maxBatchSize);
+        std::vector<PendingRequest> batch;
+        batch.reserve(batchSize);
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            batch.push_back(std::move(pending.front()));
+            pending.pop_front();
+        }
+        lock.unlock();
+        runBatch(batch);
+        lock.lock();
+    }
+}
+
+/**
+ * classifies a batch of requests in one batched forward pass (the images become the columns of one matrix) and
+ * fulfills their promises
+ * @param batch requests to classify
+ */
+void BatchingServer::runBatch(std::vector<PendingRequest> &batch)
+{
+    const int batchSize = (int) batch.size();
+    Matrix images(imageSize, batchSize, NoInit);
+    float *values = images.getData();
+    for (int j = 0; j < batchSize; j++)
+    {
+        const float *image = batch[j].image.data();
+        for (int i = 0; i < imageSize; i++)
+        {
+            values[(long) i * batchSize + j] = image[i];
+        }
+    }
+    const std::vector<Digit> digits = classifier.classifyBatch(images);
+    // counted before the results are released, so a client that got every result sees every batch counted
+    servedRequests += batchSize;
+    servedBatches++;
+    for (int j = 0; j < batchSize; j++)
+    {
+        batch[j].result.set_value(digits[j]);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * queues an image to be classified in the next batch
+ * @param image imageSize floats (copied, so the buffer may be reused as soon as submit returns)
+ * @return future of the image's Digit
+ */
+std::future<Digit> BatchingServer::submit(const float *image)
+{
+    PendingRequest request;
+    request.image.assign(image, image + imageSize);
+    request.arrival = std::chrono::steady_clock::now();
+    std::future<Digit> result = request.result.get_future();
+    bool wakeBatcher;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(std::move(request));
+        // the batcher only waits for the first request of a batch and for the batch to fill up
+        wakeBatcher = pending.size() == 1 || (int) pending.size() >= config.maxBatchSize;
+    }
+    if (wakeBatcher)
+    {
+        requestArrived.notify_one();
+    }
+    return result;
+}
+
+/**
+ * serves one stream: the calling thread reads and submits requests while a writer thread waits for their results,
+ * in order, and writes the responses, so a client that pipelines requests has them batched together.
+ * @param inputFd file descriptor to read requests from
+ * @param outputFd file descriptor to write responses to (may be inputFd, for a socket)
+ * @return number of requests served
+ */
+long BatchingServer::serveStream(const int inputFd, const int outputFd)
+{
+    std::mutex responsesMutex;
+    std::condition_variable responseQueued;
+    std::deque<std::future<Digit>> responses;
+    bool inputEnded = false;
+    std::thread writer([&]
+    {
+        bool outputOpen = true;
+        std::unique_lock<std::mutex> lock(responsesMutex);
+        while (true)
+        {
+            responseQueued.wait(lock, [&] { return inputEnded || !responses.empty(); });
+            if (responses.empty())
+            {
+                return;
+            }
+            std::future<Digit> response = std::move(responses.front());
+            responses.pop_front();
+            lock.unlock();
+            const Digit digit = response.get();
+            unsigned char frame[sizeof(uint32_t) + SERVER_RESPONSE_BYTES];
+            const uint32_t payloadSize = SERVER_RESPONSE_BYTES, value = digit.value;
+            std::memcpy(frame, &payloadSize, sizeof(uint32_t));
+            std::memcpy(frame + sizeof(uint32_t), &value, sizeof(uint32_t));
+            std::memcpy(frame + 2 * sizeof(uint32_t), &digit.probability, sizeof(float));
+            // after a failed write the results are still waited for, the requests are already queued
+            outputOpen = outputOpen && writeFully(outputFd, frame, sizeof(frame));
+            lock.lock();
+        }
+    });
+
+    const uint32_t imageBytes = (uint32_t) imageSize * (uint32_t) sizeof(float);
+    std::vector<float> image((size_t) imageSize);
+    long served = 0;
+    uint32_t payloadSize;
+    while (readFully(inputFd, &payloadSize, sizeof(payloadSize)))
+    {
+        if (payloadSize != imageBytes)
+        {
+            std::cerr << "Error: request frame of " << payloadSize << " bytes, expected " << imageBytes << std::endl;
+            break;
+        }
+        if (!readFully(inputFd, image.data(), imageBytes))
+        {
+            break;
+        }
+        std::future<Digit> response = submit(image.data());
+        {
+            std::lock_guard<std::mutex> lock(responsesMutex);
+            responses.push_back(std::move(response));
+        }
+        responseQueued.notify_one();
+        served++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(responsesMutex);
+        inputEnded = true;
+    }
+    responseQueued.notify_one();
+    writer.join();
+    return served;
+}
+
+/**
+ * listens on a Unix domain socket and serves every connection on it's own detached thread, which closes the
+ * connection when it's stream ends. never returns, exits with an error message if the socket can't be set up.
+ * @param socketPath path of the socket
+ */
+void BatchingServer::serveSocket(const std::string &socketPath)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Error: socket path " << socketPath << " is too long" << std::endl;
+        exit(1);
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    const int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());
+    if (listenFd < 0 || bind(listenFd, (const sockaddr *) &address, sizeof(address)) != 0 ||
+        listen(listenFd, SOCKET_BACKLOG) != 0)
+    {
+        std::cerr << "Error: could not listen on socket " << socketPath << ": " << std::strerror(errno) << std::endl;
+        exit(1);
+    }
+    while (true)
+    {
+        const int connectionFd = accept(listenFd, nullptr, nullptr);
+        if (connectionFd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            std::cerr << "Error: could not accept a connection: " << std::strerror(errno) << std::endl;
+            exit(1);
+        }
+        std::thread([this, connectionFd]
+        {
+            serveStream(connectionFd, connectionFd);
+            close(connectionFd);
+        }).detach();
+    }
+}
+
+/**
+ * getter for the number of requests classified so far
+ * @return number of requests
+ */
+long BatchingServer::getServedRequests() const
+{
+    return servedRequests;
+}
+
+/**
+ * getter for the number of batches run so far
+ * @return number of batches
+ */
+long BatchingServer::getServedBatches() const
+{
+    return servedBatches;
+}
@@ -0,0 +1,150 @@
+// BatchingServer.h
+/**
+ * @file BatchingServer.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief BatchingServer object class - long-running inference server that groups concurrent requests into batches.
+ *
+ * @section DESCRIPTION
+ * the server keeps one classifier resident and classifies images sent over a byte stream (stdin/stdout, or the
+ * connections of a Unix domain socket) with a length-prefixed protocol. every frame is a 32 bit unsigned payload
+ * size, in the host's byte order like the raw weight files, followed by the payload:
+ *  - a request's payload is one image: the image size floats of a vectorized image.
+ *  - a response's payload is SERVER_RESPONSE_BYTES bytes: the digit as a 32 bit unsigned integer, then it's
+ *    probability as a float.
+ * a client may pipeline requests: the responses of a stream are written in the order it's requests were read.
+ * a frame whose size isn't one image ends the stream.
+ * requests of every stream go to one queue, and a batcher thread classifies them in batches with a single batched
+ * forward pass: a batch is run as soon as it has maxBatchSize requests, or when it's oldest request has waited
+ * maxDelayMicros, whichever comes first.
+ */
+
+#ifndef BATCHINGSERVER_H
+#define BATCHINGSERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DigitClassifier.h"
+
+/**
+ * @def SERVER_RESPONSE_BYTES
+ * @brief payload size of a response frame: the digit (uint32) and it's probability (float)
+ */
+#define SERVER_RESPONSE_BYTES 8
+
+/**
+ * @struct BatchingConfig
+ * @brief when the server runs a batch: as soon as maxBatchSize requests are queued, or once the oldest queued request
+ * has waited maxDelayMicros.
+ */
+typedef struct BatchingConfig
+{
+    int maxBatchSize;
+    long maxDelayMicros;
+} BatchingConfig;
+
+/**
+ * class of BatchingServer object
+ */
+class BatchingServer
+{
+private:
+    /**
+     * @struct PendingRequest
+     * @brief a queued request: it's image, when it arrived and the promise of it's result
+     */
+    typedef struct PendingRequest
+    {
+        std::vector<float> image;
+        std::chrono::steady_clock::time_point arrival;
+        std::promise<Digit> result;
+    } PendingRequest;
+
+    const DigitClassifier &classifier;
+    const int imageSize;
+    const BatchingConfig config;
+    std::mutex queueMutex;
+    std::condition_variable requestArrived;
+    std::deque<PendingRequest> pending;
+    bool stopping;
+    std::atomic<long> servedRequests, servedBatches;
+    std::thread batcher;
+
+    /**
+     * main loop of the batcher thread: waits for a batch to be due, classifies it and fulfills it's requests, until
+     * the server is destroyed (the requests still queued then are classified first)
+     */
+    void batchLoop();
+
+    /**
+     * classifies a batch of requests in one batched forward pass and fulfills their promises
+     * @param batch requests to classify
+     */
+    void runBatch(std::vector<PendingRequest> &batch);
+
+public:
+    /**
+     * constructor for BatchingServer object: starts the batcher thread. exits with an error message if the
+     * configuration is invalid.
+     * @param classifier classifier to run the batches on (must outlive the server)
+     * @param imageSize number of floats in an image (the classifier's input size)
+     * @param config when batches are run
+     */
+    BatchingServer(const DigitClassifier &classifier, int imageSize, const BatchingConfig &config);
+
+    /**
+     * destructor for BatchingServer object: classifies the requests still queued and joins the batcher thread
+     */
+    ~BatchingServer();
+
+    BatchingServer(const BatchingServer &other) = delete;
+
+    BatchingServer &operator=(const BatchingServer &other) = delete;
+
+    /**
+     * queues an image to be classified in the next batch
+     * @param image imageSize floats (copied, so the buffer may be reused as soon as submit returns)
+     * @return future of the image's Digit
+     */
+    std::future<Digit> submit(const float *image);
+
+    /**
+     * serves one stream: reads request frames from inputFd and writes the response frames to outputFd, in order,
+     * until the input ends or a frame is invalid. several streams may be served at once from different threads,
+     * their requests are batched together.
+     * @param inputFd file descriptor to read requests from
+     * @param outputFd file descriptor to write responses to (may be inputFd, for a socket)
+     * @return number of requests served
+     */
+    long serveStream(int inputFd, int outputFd);
+
+    /**
+     * listens on a Unix domain socket and serves every connection on it's own thread (see serveStream()). a file
+     * left at socketPath by a previous run is replaced. never returns, exits with an error message if the socket
+     * can't be set up.
+     * @param socketPath path of the socket
+     */
+    void serveSocket(const std::string &socketPath);
+
+    /**
+     * getter for the number of requests classified so far
+     * @return number of requests
+     */
+    long getServedRequests() const;
+
+    /**
+     * getter for the number of batches run so far
+     * @return number of batches
+     */
+    long getServedBatches() const;
+};
+
+#endif //BATCHINGSERVER_H
@@ -0,0 +1,128 @@
+/**
+ * @file BundleConvert.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief program to convert the raw weight and bias files of an MlpNetwork into one model bundle file.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "MlpNetwork.h"
+#include "ModelBundle.h"
+
+// -------------------------- const definitions -------------------------
+
+#define DEFAULT_TOPOLOGY_ARGUMENTS (2 + 2 * MLP_SIZE)
+#define ARGUMENTS_PER_LAYER 3
+#define USAGE_MSG "Usage: bundleconvert w1 w2 w3 w4 b1 b2 b3 b4 output_bundle\n" \
+                  "       bundleconvert output_bundle weights bias activation [weights bias activation ...]\n" \
+                  "       (activation is relu, softmax, logsoftmax or identity)"
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns the number of floats in a raw file of floats. exits with an error message if the file can't be opened.
+ * @param filePath path of the file
+ * @return number of floats in the file
+ */
+static int rawFloatCount(const std::string &filePath)
+{
+    std::ifstream ifStream(filePath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!ifStream.is_open())
+    {
+        std::cerr << "Error: could not open file " << filePath << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return (int) ((long) ifStream.tellg() / (long) sizeof(float));
+}
+
+/**
+ * parses an activation's name. exits with an error message if the name is unknown.
+ * @param name activation's name
+ * @return the named ActivationType
+ */
+static ActivationType parseActivation(const char *name)
+{
+    if (std::strcmp(name, "relu") == 0)
+    {
+        return Relu;
+    }
+    if (std::strcmp(name, "softmax") == 0)
+    {
+        return Softmax;
+    }
+    if (std::strcmp(name, "identity") == 0)
+    {
+        return Identity;
+    }
+    if (std::strcmp(name, "logsoftmax") == 0)
+    {
+        return LogSoftmax;
+    }
+    std::cerr << "Error: unknown activation " << name << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    std::vector<Matrix> weights, biases;
+    std::vector<ActivationType> activations;
+    std::string bundlePath;
+    if (argc == DEFAULT_TOPOLOGY_ARGUMENTS)
+    {
+        for (int i = 0; i < MLP_SIZE; i++)
+        {
+            weights.emplace_back(weightsDims[i].rows, weightsDims[i].cols);
+            biases.emplace_back(biasDims[i].rows, biasDims[i].cols);
+            readRawMatrixFile(argv[1 + i], weights[i]);
+            readRawMatrixFile(argv[1 + MLP_SIZE + i], biases[i]);
+            activations.push_back(defaultActivation(i, MLP_SIZE));
+        }
+        bundlePath = argv[DEFAULT_TOPOLOGY_ARGUMENTS - 1];
+    }
+    else if (argc > 2 && (argc - 2) % ARGUMENTS_PER_LAYER == 0)
+    {
+        // every layer's size is taken from it's files: the bias has a value per output
+        for (int arg = 2; arg < argc; arg += ARGUMENTS_PER_LAYER)
+        {
+            const int outputs = rawFloatCount(argv[arg + 1]);
+            const int inputs = outputs == 0 ? 0 : rawFloatCount(argv[arg]) / outputs;
+            if (inputs == 0)
+            {
+                std::cerr << "Error: file " << argv[arg] << " has invalid size" << std::endl;
+                return EXIT_FAILURE;
+            }
+            weights.emplace_back(outputs, inputs);
+            biases.emplace_back(outputs, 1);
+            readRawMatrixFile(argv[arg], weights.back());
+            readRawMatrixFile(argv[arg + 1], biases.back());
+            activations.push_back(parseActivation(argv[arg + 2]));
+        }
+        bundlePath = argv[1];
+    }
+    else
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+    ModelBundle::write(bundlePath, weights.data(), biases.data(), (int) weights.size(), activations.data());
+
+    // read the bundle back, so a bad write is caught here and not when a worker starts
+    ModelBundle bundle(bundlePath);
+    MlpNetwork network(bundle);
+    std::cout << "wrote " << bundlePath << " (" << bundle.getNumLayers() << " layers, version " << BUNDLE_VERSION
+              << ")" << std::endl;
+    std::cout << "plan: " << network.getPlan().describe() << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file CachedClassifier.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief CachedClassifier object class - DigitClassifier that answers repeated images from a result cache.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <unordered_map>
+#include "CachedClassifier.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for CachedClassifier object
+ * @param classifier classifier to run on cache misses (must outlive this object)
+ * @param capacity maximal number of cached results
+ * @param numShards number of cache shards (1 puts every lookup behind one lock)
+ */
+CachedClassifier::CachedClassifier(const DigitClassifier &classifier, const long capacity, const int numShards) :
+        classifier(classifier), cache(capacity, numShards)
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * overloading operator "()": the image's values are hashed (through a packed copy if it's rows are padded) and
+ * looked up, a miss runs the wrapped classifier and caches it's result. two threads missing on the same image both
+ * classify it, the second insertion only refreshes the entry.
+ * @param img given matrix presents an image describing a digit
+ * @return Digit object presents what digit is described on the image and at what probability.
+ */
+Digit CachedClassifier::operator()(const Matrix &img) const
+{
+    const long size = (long) img.getRows() * img.getCols();
+    const ImageHash hash = img.getLeadingDim() == img.getCols() ? hashImage(img.getData(), size) :
+                           hashImage(Matrix(img, PackedRows).getData(), size);
+    Digit digit;
+    if (cache.lookup(hash, digit))
+    {
+        return digit;
+    }
+    digit = classifier(img);
+    cache.insert(hash, digit);
+    return digit;
+}
+
+/**
+ * classifies a batch of images: every column is gathered into a buffer and hashed, and each distinct image that
+ * misses is copied once into one batch for the wrapped classifier (the batch is passed as is when nothing hits and
+ * no image repeats). a column repeating an image that missed earlier in the batch isn't looked up until that image's
+ * result is cached, so it counts as a hit, as it would have if the images were classified one by one.
+ * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> CachedClassifier::classifyBatch(const Matrix &images) const
+{
+    const int rows = images.getRows(), batchSize = images.getCols(), ld = images.getLeadingDim();
+    const float *values = images.getData();
+    std::vector<Digit> digits((size_t) batchSize);
+    std::unordered_map<ImageHash, int, ImageHashHasher> missIndex;
+    std::vector<ImageHash> missHashes;
+    std::vector<int> missColumns, repeatColumns, repeatMisses;
+    std::vector<float> column((size_t) rows);
+    for (int j = 0; j < batchSize; j++)
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            column[i] = values[(long) i * ld + j];
+        }
+        const ImageHash hash = hashImage(column.data(), rows);
+        const auto repeated = missIndex.find(hash);
+        if (repeated != missIndex.end())
+        {
+            repeatColumns.push_back(j);
+            repeatMisses.push_back(repeated->second);
+        }
+        else if (!cache.lookup(hash, digits[j]))
+        {
+            missIndex.emplace(hash, (int) missColumns.size());
+            missHashes.push_back(hash);
+            missColumns.push_back(j);
+        }
+    }
+    if (missColumns.empty())
+    {
+        return digits;
+    }
+
+    const int misses = (int) missColumns.size();
+    std::vector<Digit> missDigits;
+    if (misses == batchSize)
+    {
+        missDigits = classifier.classifyBatch(images);
+    }
+    else
+    {
+        Matrix missImages(rows, misses, NoInit);
+        for (int i = 0; i < rows; i++)
+        {
+            float *missRow = missImages.getData() + (long) i * misses;
+            for (int k = 0; k < misses; k++)
+            {
+                missRow[k] = values[(long) i * ld + missColumns[k]];
+            }
+        }
+        missDigits = classifier.classifyBatch(missImages);
+    }
+    for (int k = 0; k < misses; k++)
+    {
+        digits[missColumns[k]] = missDigits[k];
+        cache.insert(missHashes[k], missDigits[k]);
+    }
+    for (int r = 0; r < (int) repeatColumns.size(); r++)
+    {
+        const int k = repeatMisses[r];
+        if (!cache.lookup(missHashes[k], digits[repeatColumns[r]]))
+        {
+            digits[repeatColumns[r]] = missDigits[k];
+        }
+    }
+    return digits;
+}
+
+/**
+ * getter for the cache's hit, miss and eviction counters
+ * @return the counters
+ */
+CacheStats CachedClassifier::getStats() const
+{
+    return cache.getStats();
+}
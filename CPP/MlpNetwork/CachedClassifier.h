@@ -0,0 +1,66 @@
+// CachedClassifier.h
+/**
+ * @file CachedClassifier.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief CachedClassifier object class - DigitClassifier that answers repeated images from a result cache.
+ */
+
+#ifndef CACHEDCLASSIFIER_H
+#define CACHEDCLASSIFIER_H
+
+#include <vector>
+#include "DigitClassifier.h"
+#include "ResultCache.h"
+
+/**
+ * @def DEFAULT_CACHE_SHARDS
+ * @brief default number of shards of a CachedClassifier's cache
+ */
+#define DEFAULT_CACHE_SHARDS 16
+
+/**
+ * class of CachedClassifier object: sits in front of another classifier (e.g. an MlpNetwork) and looks every image
+ * up in a ShardedResultCache by it's 128 bit hash before running the network, so an exactly repeated image costs a
+ * hash and a lookup instead of a forward pass. thread-safe like the classifiers it wraps, so it may be shared by a
+ * ParallelClassifier's or a BatchingServer's threads.
+ */
+class CachedClassifier : public DigitClassifier
+{
+private:
+    const DigitClassifier &classifier;
+    mutable ShardedResultCache cache;
+
+public:
+    /**
+     * constructor for CachedClassifier object
+     * @param classifier classifier to run on cache misses (must outlive this object)
+     * @param capacity maximal number of cached results
+     * @param numShards number of cache shards (1 puts every lookup behind one lock)
+     */
+    CachedClassifier(const DigitClassifier &classifier, long capacity, int numShards = DEFAULT_CACHE_SHARDS);
+
+    /**
+     * overloading operator "()": returns the cached Digit of the image, or classifies it and caches the result
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on the image and at what probability.
+     */
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * classifies a batch of images: the cached images are answered from the cache and the others are classified
+     * together in one batch by the wrapped classifier, an image repeated in the batch only once
+     * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    std::vector<Digit> classifyBatch(const Matrix &images) const override;
+
+    /**
+     * getter for the cache's hit, miss and eviction counters
+     * @return the counters
+     */
+    CacheStats getStats() const;
+};
+
+#endif //CACHEDCLASSIFIER_H
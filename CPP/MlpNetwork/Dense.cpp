@@ -12,18 +12,107 @@
 
 // ------------------------------ includes ------------------------------
 
+#include <algorithm>
+#include <utility>
 #include "Dense.h"
+#include "Gemm.h"
+#include "SimdKernels.h"
+#include "Profiler.h"
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def TRANSPOSE_BLOCK
+ * @brief side of the square blocks a matrix is transposed by, so both the rows read and the rows written stay in cache
+ */
+#define TRANSPOSE_BLOCK 32
 
 // ------------------------------ constructors -----------------------------
 
 /**
- * constructor for Dense object: constructs a Dense object from given two matrices and an Activation object
+ * constructor for Dense object: constructs a Dense object from given two matrices and an Activation object. the
+ * weights are copied into padded rows, so every row the dot products read starts on an aligned boundary.
+ * @param w given matrix represents weights
+ * @param bias given matrix (actually a vector) represents bias
+ * @param actType ActivationType for Dense's Activation
+ */
+Dense::Dense(const Matrix &w, const Matrix &bias, ActivationType actType) :
+        w(w, PaddedRows), bias(bias, PackedRows), packedW(packWeights()), activation(actType)
+{
+}
+
+/**
+ * constructor for Dense object from matrices it may take over: no values are copied, so a Dense built from
+ * views (see Matrix::view) keeps viewing the external weights. owned weights are packed here, viewed weights by
+ * the first batched product.
  * @param w given matrix represents weights
  * @param bias given matrix (actually a vector) represents bias
  * @param actType ActivationType for Dense's Activation
  */
-Dense::Dense(const Matrix &w, const Matrix &bias, ActivationType actType) : w(w), bias(bias), activation(actType)
+Dense::Dense(Matrix &&w, Matrix &&bias, ActivationType actType) :
+        w(std::move(w)), bias(bias.getLeadingDim() == bias.getCols() ? std::move(bias) : Matrix(bias, PackedRows)),
+        activation(actType)
+{
+    if (!this->w.isView())
+    {
+        packedW = packWeights();
+    }
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * writes the transpose of a rows x cols matrix into a cols x rows buffer
+ * @param src matrix to transpose
+ * @param rows number of rows of src
+ * @param cols number of columns of src
+ * @param lds distance (in elements) between two consecutive rows of src
+ * @param dst destination buffer of cols * rows values
+ */
+static void transpose(const float *src, const int rows, const int cols, const int lds, float *dst)
+{
+    for (int i0 = 0; i0 < rows; i0 += TRANSPOSE_BLOCK)
+    {
+        for (int j0 = 0; j0 < cols; j0 += TRANSPOSE_BLOCK)
+        {
+            const int iEnd = std::min(i0 + TRANSPOSE_BLOCK, rows), jEnd = std::min(j0 + TRANSPOSE_BLOCK, cols);
+            for (int i = i0; i < iEnd; i++)
+            {
+                for (int j = j0; j < jEnd; j++)
+                {
+                    dst[(long) j * rows + i] = src[(long) i * lds + j];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * packs the weights into the gemm panel layout
+ * @return the packed weights
+ */
+std::shared_ptr<const std::vector<float>> Dense::packWeights() const
+{
+    auto packed = std::make_shared<std::vector<float>>((size_t) gemmPackedASize(this->w.getRows(), this->w.getCols()));
+    gemmPackA(this->w.getRows(), this->w.getCols(), this->w.getData(), this->w.getLeadingDim(), packed->data());
+    return packed;
+}
+
+/**
+ * getter for the packed weights: packs viewed weights on the first call. safe to call from several threads at
+ * once, if two threads pack at the same time only one packed copy is kept.
+ * @return the weights packed into the gemm panel layout
+ */
+std::shared_ptr<const std::vector<float>> Dense::getPackedWeights() const
 {
+    std::shared_ptr<const std::vector<float>> packed = std::atomic_load(&packedW);
+    if (packed)
+    {
+        return packed;
+    }
+    packed = packWeights();
+    std::shared_ptr<const std::vector<float>> expected;
+    return std::atomic_compare_exchange_strong(&packedW, &expected, packed) ? packed : expected;
 }
 
 
@@ -65,7 +154,206 @@ const Activation &Dense::getActivation() const
  */
 Matrix Dense::operator()(const Matrix &m) const
 {
-    const Matrix matrixToReturn = this->w * m + this->bias;
-    return this->activation(matrixToReturn);
+    return (*this)(MatrixView(m));
 }
 
+/**
+ * overloading operator "()" for Dense object and a view: a contiguous vector goes through apply(), anything else
+ * (a batch, or a column of one whose values are strided) through the pre-packed matrix product, which reads the
+ * view through it's leading dimension.
+ * @param m given view
+ * @return new Matrix made from the viewed values after the Dense calculation and it's activation
+ */
+Matrix Dense::operator()(const MatrixView &m) const
+{
+    if (m.getCols() == 1 && m.isContiguous())
+    {
+        Matrix vectorToReturn(this->w.getRows(), 1, NoInit);
+        (*this)(m, vectorToReturn);
+        return vectorToReturn;
+    }
+    if (m.getRows() != this->w.getCols())
+    {
+        std::cerr << "Error: Dense input matrix has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    const int rows = this->w.getRows(), batchSize = m.getCols();
+    const std::shared_ptr<const std::vector<float>> packed = getPackedWeights();
+    Matrix matrixToReturn(rows, batchSize, NoInit);
+    float *values = matrixToReturn.getData();
+    {
+        PROFILE_PHASE(BiasPhase, ((long) rows * batchSize + rows) * (long) sizeof(float));
+        for (int i = 0; i < rows; i++)
+        {
+            const float rowBias = this->bias[i];
+            float *row = values + (long) i * batchSize;
+            for (int j = 0; j < batchSize; j++)
+            {
+                row[j] = rowBias;
+            }
+        }
+    }
+    {
+        PROFILE_PHASE(MatmulPhase, ((long) packed->size() + (long) m.getRows() * batchSize + 2L * rows * batchSize) *
+                                   (long) sizeof(float));
+        gemmPrepacked(rows, batchSize, this->w.getCols(), packed->data(), m.getData(), m.getLeadingDim(), 1.0f,
+                      values, batchSize);
+    }
+    PROFILE_PHASE(ActivationPhase, 2L * rows * batchSize * (long) sizeof(float));
+    return this->activation(std::move(matrixToReturn));
+}
+
+/**
+ * fused Dense calculation for a single input vector: writes act(w * x + bias) into a caller provided buffer in
+ * one sweep over the weights' rows.
+ * @param x input vector of w.getCols() values
+ * @param out output buffer of w.getRows() values (must not overlap x)
+ */
+void Dense::apply(const float *x, float *out) const
+{
+    const SimdKernelTable &kernels = simdKernels();
+    const int rows = this->w.getRows(), cols = this->w.getCols(), ld = this->w.getLeadingDim();
+    const float *weights = this->w.getData();
+    const float *biasValues = this->bias.getData();
+    // the bias (and a Relu) are fused into the dot products, so they are measured as part of the matmul phase
+    if (this->activation.getActivationType() == Relu)
+    {
+        PROFILE_PHASE(MatmulPhase, ((long) rows * cols + cols + 2L * rows) * (long) sizeof(float));
+        for (int i = 0; i < rows; i++)
+        {
+            const float value = kernels.dot(weights + (long) i * ld, x, cols) + biasValues[i];
+            out[i] = value > 0 ? value : 0;
+        }
+        return;
+    }
+    {
+        PROFILE_PHASE(MatmulPhase, ((long) rows * cols + cols + 2L * rows) * (long) sizeof(float));
+        for (int i = 0; i < rows; i++)
+        {
+            out[i] = kernels.dot(weights + (long) i * ld, x, cols) + biasValues[i];
+        }
+    }
+    PROFILE_PHASE(ActivationPhase, 2L * rows * (long) sizeof(float));
+    this->activation.applyInPlace(out, rows, 1);
+}
+
+/**
+ * fused Dense calculation for a single input vector into a caller provided output matrix (see apply()). out is
+ * only reallocated if it doesn't already have w.getRows() rows and 1 column.
+ * @param m given vector
+ * @param out output vector
+ */
+void Dense::operator()(const MatrixView &m, Matrix &out) const
+{
+    if (m.getRows() * m.getCols() != this->w.getCols())
+    {
+        std::cerr << "Error: Dense input vector has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    if (!m.isContiguous())
+    {
+        (*this)(Matrix(m), out);
+        return;
+    }
+    if (out.getRows() != this->w.getRows() || out.getCols() != 1 || out.getLeadingDim() != 1)
+    {
+        out = Matrix(this->w.getRows(), 1, NoInit);
+    }
+    this->apply(m.getData(), out.getData());
+}
+
+/**
+ * backward pass for a batch of input vectors (each column is a vector): the activation's backward pass turns the
+ * output gradient G into the gradient before the activation, then the weights' gradient is G * input^T, the bias'
+ * gradient is the sum of G's columns and the input's gradient is w^T * G. the transposes are written to a buffer
+ * once, so both products run on the gemm engine.
+ * @param input the batch the layer was run on
+ * @param output the layer's output for input (as returned by operator())
+ * @param gradient gradient with respect to output. replaced by the gradient with respect to the values before
+ * the activation.
+ * @param weightsGradient output, gradient with respect to the weights (w.getRows() x w.getCols())
+ * @param biasGradient output, gradient with respect to the bias (w.getRows() x 1)
+ * @param inputGradient output, gradient with respect to input, or nullptr when it isn't needed (first layer)
+ */
+void Dense::backward(const Matrix &input, const Matrix &output, Matrix &gradient, Matrix &weightsGradient,
+                     Matrix &biasGradient, Matrix *inputGradient) const
+{
+    const int rows = this->w.getRows(), cols = this->w.getCols(), batchSize = input.getCols();
+    if (input.getRows() != cols || output.getRows() != rows || output.getCols() != batchSize ||
+        gradient.getRows() != rows || gradient.getCols() != batchSize)
+    {
+        std::cerr << "Error: Dense backward pass matrices have invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    if (output.getLeadingDim() != batchSize || gradient.getLeadingDim() != batchSize)
+    {
+        Matrix packedGradient(gradient, PackedRows);
+        this->backward(input, Matrix(output, PackedRows), packedGradient, weightsGradient, biasGradient,
+                       inputGradient);
+        gradient = std::move(packedGradient);
+        return;
+    }
+    this->activation.backwardInPlace(output.getData(), gradient.getData(), rows, batchSize);
+
+    static thread_local std::vector<float> transposed;
+    transposed.resize(std::max((size_t) batchSize * cols, (size_t) rows * cols));
+    transpose(input.getData(), cols, batchSize, input.getLeadingDim(), transposed.data());
+    if (weightsGradient.getRows() != rows || weightsGradient.getCols() != cols)
+    {
+        weightsGradient = Matrix(rows, cols, NoInit);
+    }
+    gemm(rows, cols, batchSize, 1.0f, gradient.getData(), batchSize, transposed.data(), cols, 0.0f,
+         weightsGradient.getData(), weightsGradient.getLeadingDim());
+
+    const SimdKernelTable &kernels = simdKernels();
+    if (biasGradient.getRows() != rows || biasGradient.getCols() != 1)
+    {
+        biasGradient = Matrix(rows, 1, NoInit);
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        biasGradient.getData()[(long) i * biasGradient.getLeadingDim()] =
+                kernels.sum(gradient.getData() + (long) i * batchSize, batchSize);
+    }
+
+    if (inputGradient != nullptr)
+    {
+        transpose(this->w.getData(), rows, cols, this->w.getLeadingDim(), transposed.data());
+        if (inputGradient->getRows() != cols || inputGradient->getCols() != batchSize)
+        {
+            *inputGradient = Matrix(cols, batchSize, NoInit);
+        }
+        gemm(cols, batchSize, rows, 1.0f, transposed.data(), rows, gradient.getData(), batchSize, 0.0f,
+             inputGradient->getData(), inputGradient->getLeadingDim());
+    }
+}
+
+/**
+ * adds given steps to the weights and bias (as computed by an Optimizer) and packs the weights again. exits with
+ * an error message if the weights are a view of external weights.
+ * @param weightsStep step to add to the weights
+ * @param biasStep step to add to the bias
+ */
+void Dense::update(const Matrix &weightsStep, const Matrix &biasStep)
+{
+    const int rows = this->w.getRows(), cols = this->w.getCols();
+    if (this->w.isView() || this->bias.isView())
+    {
+        std::cerr << "Error: can't update a Dense viewing external weights" << std::endl;
+        exit(1);
+    }
+    if (weightsStep.getRows() != rows || weightsStep.getCols() != cols || biasStep.getRows() != rows ||
+        biasStep.getCols() != 1)
+    {
+        std::cerr << "Error: Dense update matrices have invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    const SimdKernelTable &kernels = simdKernels();
+    for (int i = 0; i < rows; i++)
+    {
+        float *row = this->w.getData() + (long) i * this->w.getLeadingDim();
+        kernels.add(row, weightsStep.getData() + (long) i * weightsStep.getLeadingDim(), row, cols);
+        this->bias.getData()[i] += biasStep.getData()[(long) i * biasStep.getLeadingDim()];
+    }
+    std::atomic_store(&packedW, packWeights());
+}
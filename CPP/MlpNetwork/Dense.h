@@ -11,27 +11,57 @@
 #ifndef CPP_EX1_DENSE_H
 #define CPP_EX1_DENSE_H
 
+#include <memory>
+#include <vector>
 #include "Matrix.h"
 #include "Activation.h"
 
 /**
- * class of Dense object
+ * class of Dense object. besides the weights matrix, a Dense keeps a copy of the weights packed once into the panel
+ * layout of the gemm micro-kernel (see gemmPackA()), which batched products stream from without packing. owned
+ * weights are packed when the Dense is constructed; weights viewed from an external buffer (a mapped model bundle)
+ * are packed by the first batched product, so a view only used for single vectors holds no second set of weights.
  */
 class Dense
 {
 private:
     Matrix w, bias;
+    mutable std::shared_ptr<const std::vector<float>> packedW;
     const Activation activation;
 
+    /**
+     * packs the weights into the gemm panel layout
+     * @return the packed weights
+     */
+    std::shared_ptr<const std::vector<float>> packWeights() const;
+
+    /**
+     * getter for the packed weights: packs viewed weights on the first call. safe to call from several threads at
+     * once, if two threads pack at the same time only one packed copy is kept.
+     * @return the weights packed into the gemm panel layout
+     */
+    std::shared_ptr<const std::vector<float>> getPackedWeights() const;
+
 public:
     /**
-     * constructor for Dense object: constructs a Dense object from given two matrices and an Activation object
+     * constructor for Dense object: constructs a Dense object from given two matrices and an Activation object. the
+     * weights are copied into padded rows, so every row the dot products read starts on an aligned boundary.
      * @param w given matrix represents weights
      * @param bias given matrix (actually a vector) represents bias
      * @param actType ActivationType for Dense's Activation
      */
     Dense(const Matrix &w, const Matrix &bias, ActivationType actType);
 
+    /**
+     * constructor for Dense object from matrices it may take over: no values are copied, so a Dense built from
+     * views (see Matrix::view) keeps viewing the external weights. owned weights are packed here, viewed weights by
+     * the first batched product.
+     * @param w given matrix represents weights
+     * @param bias given matrix (actually a vector) represents bias
+     * @param actType ActivationType for Dense's Activation
+     */
+    Dense(Matrix &&w, Matrix &&bias, ActivationType actType);
+
     /**
      * getter for Dense's object weights matrix
      * @return Dense's object weights matrix
@@ -53,11 +83,62 @@ public:
     /**
      * overloading operator "()" for Dense object: returns a new const Matrix made from a given Matrix after the Dense
      * calculation (according to the exercise guidelines) and it's activation function was made on it.
+     * when m has more than one column every column is a different input vector, the whole batch is multiplied by the
+     * pre-packed weights in one matrix product accumulated on top of the bias.
      * @param m given matrix
      * @return new const Matrix made from a given Matrix after the Dense calculation (according to the exercise
      * guidelines) and it's activation function was made on it.
      */
     Matrix operator()(const Matrix &m) const;
+
+    /**
+     * overloading operator "()" for Dense object and a view (see MatrixView.h): same as operator()(const Matrix &),
+     * the view is read in place through it's leading dimension, so a slice of a batch (or a single image of it) or an
+     * external buffer is run without being copied.
+     * @param m given view
+     * @return new Matrix made from the viewed values after the Dense calculation and it's activation
+     */
+    Matrix operator()(const MatrixView &m) const;
+
+    /**
+     * fused Dense calculation for a single input vector: writes act(w * x + bias) into a caller provided buffer in
+     * one sweep over the weights' rows - each output is computed, biased and (for Relu) activated while it is still
+     * in a register, so no intermediate matrix is created.
+     * @param x input vector of w.getCols() values
+     * @param out output buffer of w.getRows() values (must not overlap x)
+     */
+    void apply(const float *x, float *out) const;
+
+    /**
+     * fused Dense calculation for a single input vector into a caller provided output matrix (see apply()). out is
+     * only reallocated if it doesn't already have w.getRows() rows and 1 column.
+     * @param m given vector (a Matrix or a view of one)
+     * @param out output vector
+     */
+    void operator()(const MatrixView &m, Matrix &out) const;
+
+    /**
+     * backward pass for a batch of input vectors (each column is a vector): from the gradient of the loss with
+     * respect to the layer's outputs, computes the gradients with respect to the weights, the bias and (optionally)
+     * the inputs. the products are batched matrix products over the whole batch.
+     * @param input the batch the layer was run on
+     * @param output the layer's output for input (as returned by operator())
+     * @param gradient gradient with respect to output. replaced by the gradient with respect to the values before
+     * the activation.
+     * @param weightsGradient output, gradient with respect to the weights (w.getRows() x w.getCols())
+     * @param biasGradient output, gradient with respect to the bias (w.getRows() x 1)
+     * @param inputGradient output, gradient with respect to input, or nullptr when it isn't needed (first layer)
+     */
+    void backward(const Matrix &input, const Matrix &output, Matrix &gradient, Matrix &weightsGradient,
+                  Matrix &biasGradient, Matrix *inputGradient) const;
+
+    /**
+     * adds given steps to the weights and bias (as computed by an Optimizer) and packs the weights again. exits with
+     * an error message if the weights are a view of external weights.
+     * @param weightsStep step to add to the weights
+     * @param biasStep step to add to the bias
+     */
+    void update(const Matrix &weightsStep, const Matrix &biasStep);
 };
 
 
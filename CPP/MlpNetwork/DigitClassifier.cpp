@@ -0,0 +1,94 @@
+/**
+ * @file DigitClassifier.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief .cpp file for the DigitClassifier and ClassifierFactory classes.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <utility>
+#include "DigitClassifier.h"
+#include "MlpNetwork.h"
+#include "QuantizedMlpNetwork.h"
+#include "HalfMlpNetwork.h"
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * classifies a batch of images. the default implementation classifies the images one by one, variants with a
+ * faster batched forward pass override it.
+ * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> DigitClassifier::classifyBatch(const Matrix &images) const
+{
+    const int batchSize = images.getCols();
+    Matrix img(images.getRows(), 1, NoInit);
+    std::vector<Digit> digitsToReturn;
+    digitsToReturn.reserve(batchSize);
+    for (int j = 0; j < batchSize; j++)
+    {
+        for (int i = 0; i < images.getRows(); i++)
+        {
+            img[i] = images.getData()[(long) i * images.getLeadingDim() + j];
+        }
+        digitsToReturn.push_back((*this)(img));
+    }
+    return digitsToReturn;
+}
+
+/**
+ * static function to create the network variant of the given precision from the loaded weights and biases.
+ * @param weights array of matrices representing weights
+ * @param biases array of matrices representing biases
+ * @param precision precision of the network variant to create
+ * @return the created classifier
+ */
+std::unique_ptr<DigitClassifier> ClassifierFactory::createClassifier(Matrix weights[], Matrix biases[],
+                                                                     const InferencePrecision precision)
+{
+    switch (precision)
+    {
+        case Int8Precision:
+            return std::unique_ptr<DigitClassifier>(new QuantizedMlpNetwork(weights, biases));
+        case Float16Precision:
+            return std::unique_ptr<DigitClassifier>(new HalfMlpNetwork(weights, biases, Fp16Format));
+        case BFloat16Precision:
+            return std::unique_ptr<DigitClassifier>(new HalfMlpNetwork(weights, biases, Bf16Format));
+        default:
+            return std::unique_ptr<DigitClassifier>(new MlpNetwork(weights, biases));
+    }
+}
+
+/**
+ * static function to create the network variant of the given precision from a model bundle of any number of
+ * layers. the float variant views the bundle's weights (the bundle must outlive it), the other variants convert
+ * them.
+ * @param bundle model bundle
+ * @param precision precision of the network variant to create
+ * @return the created classifier
+ */
+std::unique_ptr<DigitClassifier> ClassifierFactory::createClassifier(const ModelBundle &bundle,
+                                                                     const InferencePrecision precision)
+{
+    if (precision == Float32Precision)
+    {
+        return std::unique_ptr<DigitClassifier>(new MlpNetwork(bundle));
+    }
+    std::vector<LayerSpec> specs;
+    for (int i = 0; i < bundle.getNumLayers(); i++)
+    {
+        specs.push_back({bundle.getWeights(i), bundle.getBias(i), bundle.getActivation(i)});
+    }
+    switch (precision)
+    {
+        case Int8Precision:
+            return std::unique_ptr<DigitClassifier>(new QuantizedMlpNetwork(std::move(specs)));
+        case Float16Precision:
+            return std::unique_ptr<DigitClassifier>(new HalfMlpNetwork(std::move(specs), Fp16Format));
+        default:
+            return std::unique_ptr<DigitClassifier>(new HalfMlpNetwork(std::move(specs), Bf16Format));
+    }
+}
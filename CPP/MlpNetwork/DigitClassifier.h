@@ -0,0 +1,91 @@
+// DigitClassifier.h
+/**
+ * @file DigitClassifier.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief DigitClassifier interface - common base class of every network variant that classifies digit images.
+ */
+
+#ifndef DIGITCLASSIFIER_H
+#define DIGITCLASSIFIER_H
+
+#include <memory>
+#include <vector>
+#include "Matrix.h"
+#include "Digit.h"
+#include "ModelBundle.h"
+
+/**
+ * @enum InferencePrecision
+ * @brief numeric precision of the network variant created when the model is loaded.
+ */
+enum InferencePrecision
+{
+    Float32Precision,
+    Int8Precision,
+    Float16Precision,
+    BFloat16Precision
+};
+
+/**
+ * class of DigitClassifier object - interface of the network variants (float, quantized...) so the variant can be
+ * chosen when the model is loaded.
+ */
+class DigitClassifier
+{
+public:
+    /**
+     * virtual destructor for DigitClassifier objects as needed due to inheritance and polymorphism.
+     */
+    virtual ~DigitClassifier() = default;
+
+    /**
+     * pure virtual overloading operator "()": returns a Digit object presents what digit is described on given matrix
+     * presenting an image and at what probability.
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    virtual Digit operator()(const Matrix &img) const = 0;
+
+    /**
+     * classifies a batch of images. the default implementation classifies the images one by one, variants with a
+     * faster batched forward pass override it.
+     * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    virtual std::vector<Digit> classifyBatch(const Matrix &images) const;
+};
+
+/**
+ * class of classifier factory object.
+ */
+class ClassifierFactory
+{
+private:
+    ClassifierFactory() = default; // constructor declared default because there is no need to enable the user to
+    // create one - classifiers are created through public static function below.
+public:
+    /**
+     * static function to create the network variant of the given precision from the loaded weights and biases.
+     * @param weights array of matrices representing weights
+     * @param biases array of matrices representing biases
+     * @param precision precision of the network variant to create
+     * @return the created classifier
+     */
+    static std::unique_ptr<DigitClassifier> createClassifier(Matrix weights[], Matrix biases[],
+                                                             InferencePrecision precision);
+
+    /**
+     * static function to create the network variant of the given precision from a model bundle of any number of
+     * layers. the float variant views the bundle's weights (the bundle must outlive it), the other variants convert
+     * them.
+     * @param bundle model bundle
+     * @param precision precision of the network variant to create
+     * @return the created classifier
+     */
+    static std::unique_ptr<DigitClassifier> createClassifier(const ModelBundle &bundle, InferencePrecision precision);
+};
+
+#endif //DIGITCLASSIFIER_H
@@ -0,0 +1,648 @@
+/**
+ * @file Gemm.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief cache-blocked general matrix multiplication engine used by Matrix's product operator.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "Gemm.h"
+#include "SimdKernels.h"
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def GEMM_SMALL_WORK
+ * @brief below this number of multiply-adds packing costs more than it saves, so a plain loop is used
+ */
+#define GEMM_SMALL_WORK (32 * 32 * 32)
+
+/**
+ * @def GEMM_X86_DISPATCH
+ * @brief on x86-64 with gcc/clang the micro-kernel is compiled once per ISA and the widest version the host supports
+ * is picked on the first product, so one binary uses FMA/AVX2 or AVX-512 registers on every host that has them.
+ */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GEMM_X86_DISPATCH 1
+#endif
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * multiplies C by beta (C is only cleared when beta is 0 so stale NaNs in C never leak into the result)
+ * @param m number of rows of C
+ * @param n number of columns of C
+ * @param beta scalar to multiply C's values with
+ * @param c pointer to C's first element
+ * @param ldc distance between two consecutive rows of C
+ */
+static void scaleC(const int m, const int n, const float beta, float *c, const int ldc)
+{
+    if (beta == 1.0f)
+    {
+        return;
+    }
+    for (int i = 0; i < m; i++)
+    {
+        float *cRow = c + (long) i * ldc;
+        for (int j = 0; j < n; j++)
+        {
+            cRow[j] = (beta == 0.0f) ? 0.0f : beta * cRow[j];
+        }
+    }
+}
+
+/**
+ * plain row-major friendly i-k-j product used for small problems: C += alpha * A * B
+ */
+static void smallGemm(const int m, const int n, const int k, const float alpha, const float *a, const int lda,
+                      const float *b, const int ldb, float *c, const int ldc)
+{
+    for (int i = 0; i < m; i++)
+    {
+        float *cRow = c + (long) i * ldc;
+        for (int p = 0; p < k; p++)
+        {
+            const float aip = alpha * a[(long) i * lda + p];
+            const float *bRow = b + (long) p * ldb;
+            for (int j = 0; j < n; j++)
+            {
+                cRow[j] += aip * bRow[j];
+            }
+        }
+    }
+}
+
+/**
+ * matrix-vector product used when B has a single column: C += alpha * A * b
+ */
+static void gemv(const int m, const int k, const float alpha, const float *a, const int lda, const float *b,
+                 const int ldb, float *c, const int ldc)
+{
+    if (ldb == 1)
+    {
+        const SimdKernelTable &kernels = simdKernels();
+        for (int i = 0; i < m; i++)
+        {
+            c[(long) i * ldc] += alpha * kernels.dot(a + (long) i * lda, b, k);
+        }
+        return;
+    }
+    for (int i = 0; i < m; i++)
+    {
+        const float *aRow = a + (long) i * lda;
+        float sum = 0;
+        for (int p = 0; p < k; p++)
+        {
+            sum += aRow[p] * b[(long) p * ldb];
+        }
+        c[(long) i * ldc] += alpha * sum;
+    }
+}
+
+/**
+ * packs an mc x kc block of A into panels of GEMM_MR rows. inside a panel the elements are stored column after
+ * column so the micro-kernel reads them sequentially. rows past mc are padded with zeros.
+ * @param mc number of rows in the block
+ * @param kc number of columns in the block
+ * @param a pointer to the block's first element
+ * @param lda distance between two consecutive rows of A
+ * @param alpha scalar folded into the packed values
+ * @param packed destination buffer of at least ceil(mc / MR) * MR * kc floats
+ */
+static void packA(const int mc, const int kc, const float *a, const int lda, const float alpha, float *packed)
+{
+    for (int i0 = 0; i0 < mc; i0 += GEMM_MR)
+    {
+        const int rows = std::min(GEMM_MR, mc - i0);
+        for (int p = 0; p < kc; p++)
+        {
+            for (int i = 0; i < rows; i++)
+            {
+                packed[i] = alpha * a[(long) (i0 + i) * lda + p];
+            }
+            for (int i = rows; i < GEMM_MR; i++)
+            {
+                packed[i] = 0;
+            }
+            packed += GEMM_MR;
+        }
+    }
+}
+
+/**
+ * packs a kc x nc block of B into panels of GEMM_NR columns. inside a panel the elements are stored row after row
+ * so the micro-kernel reads them sequentially. columns past nc are padded with zeros.
+ * @param kc number of rows in the block
+ * @param nc number of columns in the block
+ * @param b pointer to the block's first element
+ * @param ldb distance between two consecutive rows of B
+ * @param packed destination buffer of at least ceil(nc / NR) * NR * kc floats
+ */
+static void packB(const int kc, const int nc, const float *b, const int ldb, float *packed)
+{
+    for (int j0 = 0; j0 < nc; j0 += GEMM_NR)
+    {
+        const int cols = std::min(GEMM_NR, nc - j0);
+        for (int p = 0; p < kc; p++)
+        {
+            const float *bRow = b + (long) p * ldb + j0;
+            for (int j = 0; j < cols; j++)
+            {
+                packed[j] = bRow[j];
+            }
+            for (int j = cols; j < GEMM_NR; j++)
+            {
+                packed[j] = 0;
+            }
+            packed += GEMM_NR;
+        }
+    }
+}
+
+/**
+ * register-blocked micro-kernel: accumulates the product of one packed MR x kc panel of A and one packed kc x NR
+ * panel of B into an MR x NR tile held in registers, and adds the tile to C.
+ * @param kc depth of the panels
+ * @param aPanel packed panel of A
+ * @param bPanel packed panel of B
+ * @param c pointer to the tile's first element in C
+ * @param ldc distance between two consecutive rows of C
+ * @param mr number of valid rows of the tile (less than MR only at the bottom edge of C)
+ * @param nr number of valid columns of the tile (less than NR only at the right edge of C)
+ */
+static inline __attribute__((always_inline)) void microKernelBody(const int kc, const float *__restrict aPanel,
+                                                                  const float *__restrict bPanel, float *__restrict c,
+                                                                  const int ldc, const int mr, const int nr)
+{
+    float acc[GEMM_MR][GEMM_NR] = {};
+    for (int p = 0; p < kc; p++)
+    {
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++)
+        {
+            const float aip = aPanel[i];
+            for (int j = 0; j < GEMM_NR; j++)
+            {
+                acc[i][j] += aip * bPanel[j];
+            }
+        }
+        aPanel += GEMM_MR;
+        bPanel += GEMM_NR;
+    }
+    if (mr == GEMM_MR && nr == GEMM_NR)
+    {
+#pragma GCC unroll 8
+        for (int i = 0; i < GEMM_MR; i++)
+        {
+            for (int j = 0; j < GEMM_NR; j++)
+            {
+                c[(long) i * ldc + j] += acc[i][j];
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < mr; i++)
+    {
+        for (int j = 0; j < nr; j++)
+        {
+            c[(long) i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+/**
+ * pointer type of the micro-kernel versions
+ */
+typedef void (*MicroKernelFunc)(int kc, const float *aPanel, const float *bPanel, float *c, int ldc, int mr, int nr);
+
+/**
+ * micro-kernel compiled for the baseline ISA of the build
+ */
+static void microKernelGeneric(const int kc, const float *aPanel, const float *bPanel, float *c, const int ldc,
+                               const int mr, const int nr)
+{
+    microKernelBody(kc, aPanel, bPanel, c, ldc, mr, nr);
+}
+
+#ifdef GEMM_X86_DISPATCH
+
+/**
+ * micro-kernel compiled for AVX2 + FMA (each row of the tile is held in two ymm registers)
+ */
+__attribute__((target("avx2,fma")))
+static void microKernelAvx2(const int kc, const float *aPanel, const float *bPanel, float *c, const int ldc,
+                            const int mr, const int nr)
+{
+    microKernelBody(kc, aPanel, bPanel, c, ldc, mr, nr);
+}
+
+/**
+ * micro-kernel compiled for AVX-512 (each row of the tile is held in one zmm register)
+ */
+__attribute__((target("avx512f,fma")))
+static void microKernelAvx512(const int kc, const float *aPanel, const float *bPanel, float *c, const int ldc,
+                              const int mr, const int nr)
+{
+    microKernelBody(kc, aPanel, bPanel, c, ldc, mr, nr);
+}
+
+#endif
+
+/**
+ * picks the widest micro-kernel the host cpu supports
+ * @return pointer to the chosen micro-kernel
+ */
+static MicroKernelFunc selectMicroKernel()
+{
+#ifdef GEMM_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return microKernelAvx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return microKernelAvx2;
+    }
+#endif
+    return microKernelGeneric;
+}
+
+/**
+ * multiplies a packed mc x kc block of A with a packed kc x nc block of B and adds the result to C
+ */
+static void macroKernel(const int mc, const int nc, const int kc, const float *packedA, const float *packedB,
+                        float *c, const int ldc)
+{
+    static const MicroKernelFunc microKernel = selectMicroKernel();
+    for (int j0 = 0; j0 < nc; j0 += GEMM_NR)
+    {
+        const int nr = std::min(GEMM_NR, nc - j0);
+        const float *bPanel = packedB + (long) (j0 / GEMM_NR) * GEMM_NR * kc;
+        for (int i0 = 0; i0 < mc; i0 += GEMM_MR)
+        {
+            const int mr = std::min(GEMM_MR, mc - i0);
+            const float *aPanel = packedA + (long) (i0 / GEMM_MR) * GEMM_MR * kc;
+            microKernel(kc, aPanel, bPanel, c + (long) i0 * ldc + j0, ldc, mr, nr);
+        }
+    }
+}
+
+/**
+ * cache-blocked product C = alpha * A * B + beta * C (see gemm()), used for every product Strassen isn't used for
+ * and for the leaves of Strassen's recursion
+ */
+static void blockedGemm(const int m, const int n, const int k, const float alpha, const float *a, const int lda,
+                        const float *b, const int ldb, const float beta, float *c, const int ldc)
+{
+    if (m <= 0 || n <= 0)
+    {
+        return;
+    }
+    scaleC(m, n, beta, c, ldc);
+    if (k <= 0 || alpha == 0.0f)
+    {
+        return;
+    }
+    if (n == 1)
+    {
+        gemv(m, k, alpha, a, lda, b, ldb, c, ldc);
+        return;
+    }
+    if ((long) m * n * k <= GEMM_SMALL_WORK)
+    {
+        smallGemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    static thread_local std::vector<float> packedA;
+    static thread_local std::vector<float> packedB;
+    packedA.resize((size_t) GEMM_MC * GEMM_KC);
+    packedB.resize((size_t) GEMM_NC * GEMM_KC);
+
+    for (int j0 = 0; j0 < n; j0 += GEMM_NC)
+    {
+        const int nc = std::min(GEMM_NC, n - j0);
+        for (int p0 = 0; p0 < k; p0 += GEMM_KC)
+        {
+            const int kc = std::min(GEMM_KC, k - p0);
+            packB(kc, nc, b + (long) p0 * ldb + j0, ldb, packedB.data());
+            for (int i0 = 0; i0 < m; i0 += GEMM_MC)
+            {
+                const int mc = std::min(GEMM_MC, m - i0);
+                packA(mc, kc, a + (long) i0 * lda + p0, lda, alpha, packedA.data());
+                macroKernel(mc, nc, kc, packedA.data(), packedB.data(), c + (long) i0 * ldc + j0, ldc);
+            }
+        }
+    }
+}
+
+/**
+ * the policy gemm() picks between the blocked product and Strassen's with
+ */
+static std::atomic<GemmPolicy> gemmPolicy(GemmAuto);
+
+/**
+ * computes dst = x + sign * y element-wise for rows x cols blocks (sign is 1 or -1)
+ * @param rows number of rows of the blocks
+ * @param cols number of columns of the blocks
+ * @param x pointer to x's first element
+ * @param ldx distance between two consecutive rows of x
+ * @param y pointer to y's first element
+ * @param ldy distance between two consecutive rows of y
+ * @param sign 1 to add y, -1 to subtract it
+ * @param dst pointer to the destination's first element (may be x or y)
+ * @param ldd distance between two consecutive rows of the destination
+ */
+static void combineBlocks(const int rows, const int cols, const float *x, const int ldx, const float *y,
+                          const int ldy, const float sign, float *dst, const int ldd)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        const float *xRow = x + (long) i * ldx;
+        const float *yRow = y + (long) i * ldy;
+        float *dstRow = dst + (long) i * ldd;
+        for (int j = 0; j < cols; j++)
+        {
+            dstRow[j] = xRow[j] + sign * yRow[j];
+        }
+    }
+}
+
+/**
+ * computes C = A * B with Strassen-Winograd's recursion: the quadrants of C are built from 7 products of half sized
+ * blocks and 15 additions, with the schedule of Douglas et al. that needs only two temporaries per level (X holds
+ * the sums of A's quadrants and then the product A11 * B11, Y the sums of B's quadrants) - the other products are
+ * written straight into quadrants of C that are still free. a level recurses while every dimension is above
+ * GEMM_STRASSEN_CUTOVER, below that the blocked product is faster than 7/8 of the multiplications.
+ * m, n and k must be divisible by 2 at every level of the recursion (see strassenGemm()).
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ * @param a pointer to A's first element
+ * @param lda distance between two consecutive rows of A
+ * @param b pointer to B's first element
+ * @param ldb distance between two consecutive rows of B
+ * @param c pointer to C's first element (C's previous values are ignored)
+ * @param ldc distance between two consecutive rows of C
+ */
+static void strassenRecursion(const int m, const int n, const int k, const float *a, const int lda, const float *b,
+                              const int ldb, float *c, const int ldc)
+{
+    if (std::min(std::min(m, n), k) <= GEMM_STRASSEN_CUTOVER)
+    {
+        blockedGemm(m, n, k, 1.0f, a, lda, b, ldb, 0.0f, c, ldc);
+        return;
+    }
+    const int hm = m / 2, hn = n / 2, hk = k / 2;
+    const float *a11 = a, *a12 = a + hk, *a21 = a + (long) hm * lda, *a22 = a21 + hk;
+    const float *b11 = b, *b12 = b + hn, *b21 = b + (long) hk * ldb, *b22 = b21 + hn;
+    float *c11 = c, *c12 = c + hn, *c21 = c + (long) hm * ldc, *c22 = c21 + hn;
+
+    // X holds an hm x hk sum of A's quadrants and later the hm x hn product P1, so it's rows are as wide as either
+    const int ldx = std::max(hk, hn), ldy = hn;
+    std::unique_ptr<float[]> xBuffer(new float[(size_t) hm * ldx]), yBuffer(new float[(size_t) hk * ldy]);
+    float *x = xBuffer.get(), *y = yBuffer.get();
+
+    combineBlocks(hm, hk, a11, lda, a21, lda, -1, x, ldx);          // S3 = A11 - A21
+    combineBlocks(hk, hn, b22, ldb, b12, ldb, -1, y, ldy);          // T3 = B22 - B12
+    strassenRecursion(hm, hn, hk, x, ldx, y, ldy, c21, ldc);        // P7 = S3 * T3
+    combineBlocks(hm, hk, a21, lda, a22, lda, 1, x, ldx);           // S1 = A21 + A22
+    combineBlocks(hk, hn, b12, ldb, b11, ldb, -1, y, ldy);          // T1 = B12 - B11
+    strassenRecursion(hm, hn, hk, x, ldx, y, ldy, c22, ldc);        // P5 = S1 * T1
+    combineBlocks(hm, hk, x, ldx, a11, lda, -1, x, ldx);            // S2 = S1 - A11
+    combineBlocks(hk, hn, b22, ldb, y, ldy, -1, y, ldy);            // T2 = B22 - T1
+    strassenRecursion(hm, hn, hk, x, ldx, y, ldy, c12, ldc);        // P6 = S2 * T2
+    combineBlocks(hm, hk, a12, lda, x, ldx, -1, x, ldx);            // S4 = A12 - S2
+    strassenRecursion(hm, hn, hk, x, ldx, b22, ldb, c11, ldc);      // P3 = S4 * B22
+    strassenRecursion(hm, hn, hk, a11, lda, b11, ldb, x, ldx);      // P1 = A11 * B11
+    combineBlocks(hm, hn, x, ldx, c12, ldc, 1, c12, ldc);           // U2 = P1 + P6
+    combineBlocks(hm, hn, c12, ldc, c21, ldc, 1, c21, ldc);         // U3 = U2 + P7
+    combineBlocks(hm, hn, c12, ldc, c22, ldc, 1, c12, ldc);         // U4 = U2 + P5
+    combineBlocks(hm, hn, c21, ldc, c22, ldc, 1, c22, ldc);         // C22 = U3 + P5
+    combineBlocks(hm, hn, c12, ldc, c11, ldc, 1, c12, ldc);         // C12 = U4 + P3
+    combineBlocks(hk, hn, y, ldy, b21, ldb, -1, y, ldy);            // T4 = T2 - B21
+    strassenRecursion(hm, hn, hk, a22, lda, y, ldy, c11, ldc);      // P4 = A22 * T4
+    combineBlocks(hm, hn, c21, ldc, c11, ldc, -1, c21, ldc);        // C21 = U3 - P4
+    strassenRecursion(hm, hn, hk, a12, lda, b21, ldb, c11, ldc);    // P2 = A12 * B21
+    combineBlocks(hm, hn, x, ldx, c11, ldc, 1, c11, ldc);           // C11 = P1 + P2
+}
+
+/**
+ * returns the number of levels strassenRecursion() recurses for a product whose smallest dimension is given
+ * @param smallest smallest of the product's dimensions
+ * @return number of levels (0 if the blocked product is used straight away)
+ */
+static int strassenLevels(int smallest)
+{
+    int levels = 0;
+    while (smallest > GEMM_STRASSEN_CUTOVER)
+    {
+        smallest = (smallest + 1) / 2;
+        levels++;
+    }
+    return levels;
+}
+
+/**
+ * copies a rows x cols block into the top left corner of a zeroed paddedRows x paddedCols buffer
+ * @param rows number of rows of the block
+ * @param cols number of columns of the block
+ * @param src pointer to the block's first element
+ * @param lds distance between two consecutive rows of the block
+ * @param paddedRows number of rows of the buffer
+ * @param paddedCols number of columns of the buffer
+ * @param padded the buffer
+ */
+static void padBlock(const int rows, const int cols, const float *src, const int lds, const int paddedRows,
+                     const int paddedCols, std::vector<float> &padded)
+{
+    padded.assign((size_t) paddedRows * paddedCols, 0.0f);
+    for (int i = 0; i < rows; i++)
+    {
+        std::copy(src + (long) i * lds, src + (long) i * lds + cols, padded.data() + (long) i * paddedCols);
+    }
+}
+
+/**
+ * computes C = alpha * A * B + beta * C (see gemm()) with Strassen-Winograd's algorithm. every dimension is padded
+ * with zeros to a multiple of 2^levels, so every level of the recursion splits evenly (the padding adds at most
+ * 2^levels - 1 rows or columns, a few percent of the work for the sizes Strassen is used for). when C needs no
+ * padding (m and n are multiples of 2^levels, k may still be padded), alpha is 1 and beta is 0 the product is written
+ * straight into C; otherwise it's computed into a temporary that is then scaled into C.
+ */
+static void strassenGemm(const int m, const int n, const int k, const float alpha, const float *a, const int lda,
+                         const float *b, const int ldb, const float beta, float *c, const int ldc)
+{
+    const int levels = strassenLevels(std::min(std::min(m, n), k));
+    const int multiple = 1 << levels;
+    const int pm = (m + multiple - 1) / multiple * multiple;
+    const int pn = (n + multiple - 1) / multiple * multiple;
+    const int pk = (k + multiple - 1) / multiple * multiple;
+
+    std::vector<float> paddedA, paddedB, product;
+    if (pm != m || pk != k)
+    {
+        padBlock(m, k, a, lda, pm, pk, paddedA);
+    }
+    if (pk != k || pn != n)
+    {
+        padBlock(k, n, b, ldb, pk, pn, paddedB);
+    }
+    const float *pa = paddedA.empty() ? a : paddedA.data();
+    const float *pb = paddedB.empty() ? b : paddedB.data();
+    const int pLda = paddedA.empty() ? lda : pk, pLdb = paddedB.empty() ? ldb : pn;
+    if (pm == m && pn == n && alpha == 1.0f && beta == 0.0f)
+    {
+        strassenRecursion(m, n, pk, pa, pLda, pb, pLdb, c, ldc);
+        return;
+    }
+    product.resize((size_t) pm * pn);
+    strassenRecursion(pm, pn, pk, pa, pLda, pb, pLdb, product.data(), pn);
+    scaleC(m, n, beta, c, ldc);
+    for (int i = 0; i < m; i++)
+    {
+        const float *productRow = product.data() + (long) i * pn;
+        float *cRow = c + (long) i * ldc;
+        for (int j = 0; j < n; j++)
+        {
+            cRow[j] += alpha * productRow[j];
+        }
+    }
+}
+
+/**
+ * returns whether gemm() computes a product with Strassen's algorithm under the current policy
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ * @return true to use strassenGemm()
+ */
+static bool useStrassen(const int m, const int n, const int k)
+{
+    const int smallest = std::min(std::min(m, n), k);
+    switch (gemmPolicy.load(std::memory_order_relaxed))
+    {
+        case GemmStrassen:
+            return smallest > GEMM_STRASSEN_CUTOVER;
+        case GemmAuto:
+            return smallest >= GEMM_STRASSEN_AUTO_SIZE &&
+                   std::max(std::max(m, n), k) <= GEMM_STRASSEN_MAX_ASPECT * smallest;
+        default:
+            return false;
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * computes C = alpha * A * B + beta * C for row-major matrices. A is m x k, B is k x n and C is m x n. the product
+ * is computed block by block: blocks of A and B are packed into contiguous panels sized for the cache hierarchy and
+ * every MR x NR tile of C is accumulated in registers by the micro-kernel. large, roughly square products use
+ * Strassen-Winograd's algorithm instead, as set by setGemmPolicy().
+ * when beta is 0, C is only written and its previous values are ignored.
+ */
+void gemm(const int m, const int n, const int k, const float alpha, const float *a, const int lda, const float *b,
+          const int ldb, const float beta, float *c, const int ldc)
+{
+    if (m > 0 && n > 0 && k > 0 && alpha != 0.0f && useStrassen(m, n, k))
+    {
+        strassenGemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        return;
+    }
+    blockedGemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+/**
+ * sets the policy gemm() picks between the blocked product and Strassen's with (GemmAuto by default). the policy is
+ * shared by every thread.
+ * @param policy the policy
+ */
+void setGemmPolicy(const GemmPolicy policy)
+{
+    gemmPolicy.store(policy, std::memory_order_relaxed);
+}
+
+/**
+ * getter for the policy gemm() picks between the blocked product and Strassen's with
+ * @return the policy
+ */
+GemmPolicy getGemmPolicy()
+{
+    return gemmPolicy.load(std::memory_order_relaxed);
+}
+
+/**
+ * returns the number of floats gemmPackA() writes for an m x k matrix A
+ * @param m number of rows of A
+ * @param k number of columns of A
+ * @return size of the packed A buffer
+ */
+long gemmPackedASize(const int m, const int k)
+{
+    return (long) (m + GEMM_MR - 1) / GEMM_MR * GEMM_MR * k;
+}
+
+/**
+ * packs a whole m x k matrix A ahead of time into the panel layout gemm() packs blocks of A into on every call.
+ * the KC deep block starting at column p0 starts at p0 * roundUp(m, MR), and inside it the MC block starting at
+ * row i0 starts at i0 * kc (MC is a multiple of MR, so every block before it is full).
+ */
+void gemmPackA(const int m, const int k, const float *a, const int lda, float *packed)
+{
+    static_assert(GEMM_MC % GEMM_MR == 0, "packed A blocks must hold whole panels");
+    const long paddedRows = gemmPackedASize(m, 1);
+    for (int p0 = 0; p0 < k; p0 += GEMM_KC)
+    {
+        const int kc = std::min(GEMM_KC, k - p0);
+        for (int i0 = 0; i0 < m; i0 += GEMM_MC)
+        {
+            const int mc = std::min(GEMM_MC, m - i0);
+            packA(mc, kc, a + (long) i0 * lda + p0, lda, 1.0f, packed + p0 * paddedRows + (long) i0 * kc);
+        }
+    }
+}
+
+/**
+ * computes C = A * B + beta * C (see gemm()) for an A already packed by gemmPackA(): only B is packed.
+ */
+void gemmPrepacked(const int m, const int n, const int k, const float *packedA, const float *b, const int ldb,
+                   const float beta, float *c, const int ldc)
+{
+    if (m <= 0 || n <= 0)
+    {
+        return;
+    }
+    scaleC(m, n, beta, c, ldc);
+    if (k <= 0)
+    {
+        return;
+    }
+
+    static thread_local std::vector<float> packedB;
+    packedB.resize((size_t) GEMM_NC * GEMM_KC);
+
+    const long paddedRows = gemmPackedASize(m, 1);
+    for (int j0 = 0; j0 < n; j0 += GEMM_NC)
+    {
+        const int nc = std::min(GEMM_NC, n - j0);
+        for (int p0 = 0; p0 < k; p0 += GEMM_KC)
+        {
+            const int kc = std::min(GEMM_KC, k - p0);
+            packB(kc, nc, b + (long) p0 * ldb + j0, ldb, packedB.data());
+            for (int i0 = 0; i0 < m; i0 += GEMM_MC)
+            {
+                const int mc = std::min(GEMM_MC, m - i0);
+                macroKernel(mc, nc, kc, packedA + p0 * paddedRows + (long) i0 * kc, packedB.data(),
+                            c + (long) i0 * ldc + j0, ldc);
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+// Gemm.h
+/**
+ * @file Gemm.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief cache-blocked general matrix multiplication engine used by Matrix's product operator.
+ */
+
+#ifndef GEMM_H
+#define GEMM_H
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def GEMM_MR
+ * @brief number of rows of C computed by one call of the register-blocked micro-kernel
+ */
+#define GEMM_MR 6
+
+/**
+ * @def GEMM_NR
+ * @brief number of columns of C computed by one call of the register-blocked micro-kernel
+ */
+#define GEMM_NR 16
+
+/**
+ * @def GEMM_MC
+ * @brief number of rows of A packed together - an MC x KC block of A is sized to stay in L2 cache
+ */
+#define GEMM_MC 120
+
+/**
+ * @def GEMM_KC
+ * @brief depth of a packed block - a KC x NR panel of B is sized to stay in L1 cache
+ */
+#define GEMM_KC 256
+
+/**
+ * @def GEMM_NC
+ * @brief number of columns of B packed together - a KC x NC block of B is sized to stay in L3 cache
+ */
+#define GEMM_NC 4080
+
+/**
+ * @def GEMM_STRASSEN_CUTOVER
+ * @brief Strassen's recursion stops once a dimension is at most this size and the blocked product computes the leaf
+ */
+#define GEMM_STRASSEN_CUTOVER 768
+
+/**
+ * @def GEMM_STRASSEN_AUTO_SIZE
+ * @brief under GemmAuto, Strassen's algorithm is used for products whose every dimension is at least this size
+ */
+#define GEMM_STRASSEN_AUTO_SIZE 2048
+
+/**
+ * @def GEMM_STRASSEN_MAX_ASPECT
+ * @brief under GemmAuto, Strassen's algorithm is only used when no dimension is more than this times the smallest
+ */
+#define GEMM_STRASSEN_MAX_ASPECT 2
+
+/**
+ * @enum GemmPolicy
+ * @brief how gemm() picks the algorithm of a product:
+ *  - GemmAuto uses Strassen-Winograd for large, roughly square products (see GEMM_STRASSEN_AUTO_SIZE) and the
+ *    blocked product otherwise.
+ *  - GemmBlocked always uses the blocked product.
+ *  - GemmStrassen uses Strassen-Winograd whenever every dimension is above GEMM_STRASSEN_CUTOVER.
+ * Strassen-Winograd does 7/8 of the multiplications per level, but it's rounding error grows with the depth of the
+ * recursion (it's norm-wise, not element-wise, bounded), so GemmBlocked is the choice when results must match the
+ * blocked product closely.
+ */
+enum GemmPolicy
+{
+    GemmAuto,
+    GemmBlocked,
+    GemmStrassen
+};
+
+// ------------------------------ functions ------------------------------
+
+/**
+ * computes C = alpha * A * B + beta * C for row-major matrices. A is m x k, B is k x n and C is m x n. the product
+ * is computed block by block: blocks of A and B are packed into contiguous panels sized for the cache hierarchy and
+ * every MR x NR tile of C is accumulated in registers by the micro-kernel. large, roughly square products use
+ * Strassen-Winograd's algorithm instead, as set by setGemmPolicy().
+ * when beta is 0, C is only written and its previous values are ignored.
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ * @param alpha scalar to multiply the product A * B with
+ * @param a pointer to A's first element
+ * @param lda distance (in elements) between two consecutive rows of A
+ * @param b pointer to B's first element
+ * @param ldb distance (in elements) between two consecutive rows of B
+ * @param beta scalar to multiply C's previous values with
+ * @param c pointer to C's first element
+ * @param ldc distance (in elements) between two consecutive rows of C
+ */
+void gemm(int m, int n, int k, float alpha, const float *a, int lda, const float *b, int ldb, float beta, float *c,
+          int ldc);
+
+/**
+ * sets the policy gemm() picks between the blocked product and Strassen's with (GemmAuto by default). the policy is
+ * shared by every thread.
+ * @param policy the policy
+ */
+void setGemmPolicy(GemmPolicy policy);
+
+/**
+ * getter for the policy gemm() picks between the blocked product and Strassen's with
+ * @return the policy
+ */
+GemmPolicy getGemmPolicy();
+
+/**
+ * returns the number of floats gemmPackA() writes for an m x k matrix A
+ * @param m number of rows of A
+ * @param k number of columns of A
+ * @return size of the packed A buffer
+ */
+long gemmPackedASize(int m, int k);
+
+/**
+ * packs a whole m x k matrix A ahead of time into the panel layout gemm() packs blocks of A into on every call
+ * (KC deep blocks, each holding panels of GEMM_MR interleaved rows), so a matrix that multiplies many times, such as
+ * a layer's weights, is packed once and the micro-kernel streams it sequentially.
+ * @param m number of rows of A
+ * @param k number of columns of A
+ * @param a pointer to A's first element
+ * @param lda distance (in elements) between two consecutive rows of A
+ * @param packed destination buffer of gemmPackedASize(m, k) floats
+ */
+void gemmPackA(int m, int k, const float *a, int lda, float *packed);
+
+/**
+ * computes C = A * B + beta * C (see gemm()) for an A already packed by gemmPackA(): only B is packed.
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ * @param packedA A packed by gemmPackA(m, k, ...)
+ * @param b pointer to B's first element
+ * @param ldb distance (in elements) between two consecutive rows of B
+ * @param beta scalar to multiply C's previous values with
+ * @param c pointer to C's first element
+ * @param ldc distance (in elements) between two consecutive rows of C
+ */
+void gemmPrepacked(int m, int n, int k, const float *packedA, const float *b, int ldb, float beta, float *c, int ldc);
+
+#endif //GEMM_H
@@ -0,0 +1,133 @@
+/**
+ * @file HalfDense.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief HalfDense object class - Dense layer with weights and bias stored in a 16 bit floating point format
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <utility>
+#include <algorithm>
+#include "HalfDense.h"
+#include "Gemm.h"
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def HALF_BLOCK_ELEMS
+ * @brief number of weights converted to float at once for a batch product (64KB of floats, fits in L2)
+ */
+#define HALF_BLOCK_ELEMS 16384
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for HalfDense object: converts given float weights and bias to the given format. exits with an error
+ * message if the bias isn't a vector of one value per row of the weights.
+ * @param w given matrix represents weights
+ * @param bias given matrix (actually a vector) represents bias
+ * @param actType ActivationType for HalfDense's Activation
+ * @param format 16 bit storage format
+ */
+HalfDense::HalfDense(const Matrix &w, const Matrix &bias, ActivationType actType, HalfFormat format) :
+        rows(w.getRows()), cols(w.getCols()), format(format), weights((size_t) w.getRows() * w.getCols()),
+        bias(bias.getRows()), activation(actType)
+{
+    if (bias.getRows() != rows || bias.getCols() != 1)
+    {
+        std::cerr << "Error: biases vector has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        convertToHalf(w.getData() + (long) i * w.getLeadingDim(), this->weights.data() + (long) i * cols, cols, format);
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        this->bias[i] = floatToHalf(bias.elementAt(i), format);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the layer's storage format
+ * @return layer's storage format
+ */
+HalfFormat HalfDense::getFormat() const
+{
+    return this->format;
+}
+
+/**
+ * returns the weights matrix the stored 16 bit weights stand for
+ * @return weights converted back to float
+ */
+Matrix HalfDense::getWeights() const
+{
+    Matrix matrixToReturn(rows, cols, NoInit);
+    convertToFloat(weights.data(), matrixToReturn.getData(), (long) rows * cols, format);
+    return matrixToReturn;
+}
+
+/**
+ * overloading operator "()" for HalfDense object: returns act(w * m + bias) for a batch of input columns. the
+ * weights are converted to float a block of rows at a time (the block stays in cache) and multiplied by gemm.
+ * @param m given matrix, each of it's columns is one input vector
+ * @return output matrix, each of it's columns is the output of the matching input column
+ */
+Matrix HalfDense::operator()(const Matrix &m) const
+{
+    if (m.getRows() != cols)
+    {
+        std::cerr << "Error: HalfDense input has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    const int batchSize = m.getCols();
+    Matrix matrixToReturn(rows, batchSize, NoInit);
+    if (batchSize == 1)
+    {
+        this->apply(m.getData(), matrixToReturn.getData());
+        return matrixToReturn;
+    }
+    const int blockRows = std::max(1, std::min(rows, HALF_BLOCK_ELEMS / std::max(cols, 1)));
+    static thread_local std::vector<float> block;
+    if (block.size() < (size_t) blockRows * cols)
+    {
+        block.resize((size_t) blockRows * cols);
+    }
+    float *values = matrixToReturn.getData();
+    for (int i0 = 0; i0 < rows; i0 += blockRows)
+    {
+        const int blockHeight = std::min(blockRows, rows - i0);
+        convertToFloat(weights.data() + (long) i0 * cols, block.data(), (long) blockHeight * cols, format);
+        for (int i = 0; i < blockHeight; i++)
+        {
+            const float rowBias = halfToFloat(bias[i0 + i], format);
+            float *row = values + (long) (i0 + i) * batchSize;
+            for (int j = 0; j < batchSize; j++)
+            {
+                row[j] = rowBias;
+            }
+        }
+        gemm(blockHeight, batchSize, cols, 1.0f, block.data(), cols, m.getData(), m.getLeadingDim(), 1.0f,
+             values + (long) i0 * batchSize, batchSize);
+    }
+    return this->activation(std::move(matrixToReturn));
+}
+
+/**
+ * fused HalfDense calculation for a single input vector: writes act(w * x + bias) into a caller provided buffer
+ * @param x input vector of w.getCols() values
+ * @param out output buffer of w.getRows() values (must not overlap x)
+ */
+void HalfDense::apply(const float *x, float *out) const
+{
+    for (int i = 0; i < rows; i++)
+    {
+        out[i] = dotHalf(weights.data() + (long) i * cols, x, cols, format) + halfToFloat(bias[i], format);
+    }
+    this->activation.applyInPlace(out, rows, 1);
+}
@@ -0,0 +1,72 @@
+// HalfDense.h
+/**
+ * @file HalfDense.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief HalfDense object class - Dense layer with weights and bias stored in a 16 bit floating point format
+ */
+
+#ifndef HALFDENSE_H
+#define HALFDENSE_H
+
+#include <vector>
+#include <cstdint>
+#include "Matrix.h"
+#include "Activation.h"
+#include "HalfFloat.h"
+
+/**
+ * class of HalfDense object: a Dense layer whose weights and bias are stored as fp16 or bf16, halving the layer's
+ * memory and weight traffic. the values are converted back to float in registers (or in cache sized blocks for a
+ * batch) and every sum is accumulated in float, so no calibration is needed.
+ */
+class HalfDense
+{
+private:
+    int rows, cols;
+    HalfFormat format;
+    std::vector<uint16_t> weights;
+    std::vector<uint16_t> bias;
+    const Activation activation;
+
+public:
+    /**
+     * constructor for HalfDense object: converts given float weights and bias to the given format. exits with an
+     * error message if the bias isn't a vector of one value per row of the weights.
+     * @param w given matrix represents weights
+     * @param bias given matrix (actually a vector) represents bias
+     * @param actType ActivationType for HalfDense's Activation
+     * @param format 16 bit storage format
+     */
+    HalfDense(const Matrix &w, const Matrix &bias, ActivationType actType, HalfFormat format);
+
+    /**
+     * getter for the layer's storage format
+     * @return layer's storage format
+     */
+    HalfFormat getFormat() const;
+
+    /**
+     * returns the weights matrix the stored 16 bit weights stand for
+     * @return weights converted back to float
+     */
+    Matrix getWeights() const;
+
+    /**
+     * overloading operator "()" for HalfDense object: returns act(w * m + bias) for a batch of input columns. the
+     * weights are converted to float a block of rows at a time (the block stays in cache) and multiplied by gemm.
+     * @param m given matrix, each of it's columns is one input vector
+     * @return output matrix, each of it's columns is the output of the matching input column
+     */
+    Matrix operator()(const Matrix &m) const;
+
+    /**
+     * fused HalfDense calculation for a single input vector: writes act(w * x + bias) into a caller provided buffer
+     * @param x input vector of w.getCols() values
+     * @param out output buffer of w.getRows() values (must not overlap x)
+     */
+    void apply(const float *x, float *out) const;
+};
+
+#endif //HALFDENSE_H
@@ -0,0 +1,474 @@
+/**
+ * @file HalfFloat.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief 16 bit floating point storage formats (IEEE half, bfloat16): conversions and float accumulating kernels.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cmath>
+#include <cstring>
+#include "HalfFloat.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HALF_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def FP16_EXP_REBIAS
+ * @brief difference of the float and fp16 exponent biases (127 - 15), in float's exponent position
+ */
+#define FP16_EXP_REBIAS 0x38000000u
+
+/**
+ * @def FP16_OVERFLOW_BITS
+ * @brief bits of 65520.0f, the smallest float that rounds to fp16 infinity
+ */
+#define FP16_OVERFLOW_BITS 0x477ff000u
+
+/**
+ * @def FP16_MIN_NORMAL_BITS
+ * @brief bits of 2^-14, the smallest normal fp16 value
+ */
+#define FP16_MIN_NORMAL_BITS 0x38800000u
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * returns the bits of a float
+ */
+static inline uint32_t floatBits(const float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * returns the float of given bits
+ */
+static inline float bitsToFloat(const uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * software float to fp16 conversion, round to nearest even
+ */
+static uint16_t floatToFp16(const float value)
+{
+    const uint32_t bits = floatBits(value);
+    const uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000);
+    const uint32_t absBits = bits & 0x7fffffff;
+    if (absBits > 0x7f800000)
+    {
+        return sign | 0x7e00; // nan
+    }
+    if (absBits >= FP16_OVERFLOW_BITS)
+    {
+        return sign | 0x7c00; // infinity
+    }
+    if (absBits < FP16_MIN_NORMAL_BITS)
+    {
+        // subnormal fp16: the value in units of 2^-24, rounded by the current (nearest even) rounding mode
+        return sign | (uint16_t) std::lrint(bitsToFloat(absBits) * 16777216.0f);
+    }
+    const uint32_t rounded = absBits + 0xfff + ((absBits >> 13) & 1);
+    return sign | (uint16_t) ((rounded - FP16_EXP_REBIAS) >> 13);
+}
+
+/**
+ * software fp16 to float conversion
+ */
+static float fp16ToFloat(const uint16_t value)
+{
+    const uint32_t sign = (uint32_t) (value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1f;
+    const uint32_t mantissa = value & 0x3ff;
+    if (exponent == 0)
+    {
+        const float subnormal = (float) mantissa * (1.0f / 16777216.0f);
+        return sign ? -subnormal : subnormal;
+    }
+    if (exponent == 0x1f)
+    {
+        return bitsToFloat(sign | 0x7f800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | (((exponent << 10 | mantissa) << 13) + FP16_EXP_REBIAS));
+}
+
+/**
+ * software float to bf16 conversion, round to nearest even
+ */
+static uint16_t floatToBf16(const float value)
+{
+    const uint32_t bits = floatBits(value);
+    if ((bits & 0x7fffffff) > 0x7f800000)
+    {
+        return (uint16_t) ((bits >> 16) | 0x40); // nan, keep it quiet
+    }
+    return (uint16_t) ((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+}
+
+/**
+ * software bf16 to float conversion
+ */
+static inline float bf16ToFloat(const uint16_t value)
+{
+    return bitsToFloat((uint32_t) value << 16);
+}
+
+/**
+ * pointer type of the dot product versions
+ */
+typedef float (*DotHalfFunc)(const uint16_t *a, const float *b, long n);
+
+/**
+ * pointer type of the bulk conversion versions
+ */
+typedef void (*ToFloatFunc)(const uint16_t *values, float *out, long n);
+
+/**
+ * fp16 dot product compiled for the baseline ISA of the build
+ */
+static float dotFp16Generic(const uint16_t *a, const float *b, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += fp16ToFloat(a[i]) * b[i];
+    }
+    return result;
+}
+
+/**
+ * bf16 dot product compiled for the baseline ISA of the build
+ */
+static float dotBf16Generic(const uint16_t *a, const float *b, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += bf16ToFloat(a[i]) * b[i];
+    }
+    return result;
+}
+
+/**
+ * fp16 to float conversion compiled for the baseline ISA of the build
+ */
+static void fp16ToFloatGeneric(const uint16_t *values, float *out, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = fp16ToFloat(values[i]);
+    }
+}
+
+/**
+ * bf16 to float conversion compiled for the baseline ISA of the build
+ */
+static void bf16ToFloatGeneric(const uint16_t *values, float *out, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = bf16ToFloat(values[i]);
+    }
+}
+
+#ifdef HALF_X86_DISPATCH
+
+/**
+ * sums the 8 lanes of an AVX register
+ */
+__attribute__((target("avx2")))
+static float sumLanesAvx2(const __m256 acc)
+{
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5])) + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+}
+
+/**
+ * loads 8 bf16 values as floats (a bf16 is the upper half of a float)
+ */
+__attribute__((target("avx2")))
+static inline __m256 loadBf16Avx2(const uint16_t *values)
+{
+    const __m256i widened = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) values));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(widened, 16));
+}
+
+/**
+ * fp16 dot product for AVX2 + F16C + FMA, two accumulators
+ */
+__attribute__((target("avx2,f16c,fma")))
+static float dotFp16Avx2(const uint16_t *a, const float *b, const long n)
+{
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (a + i))),
+                               _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (a + i + 8))),
+                               _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (a + i))),
+                               _mm256_loadu_ps(b + i), acc0);
+    }
+    return sumLanesAvx2(_mm256_add_ps(acc0, acc1)) + dotFp16Generic(a + i, b + i, n - i);
+}
+
+/**
+ * bf16 dot product for AVX2 + FMA, two accumulators
+ */
+__attribute__((target("avx2,fma")))
+static float dotBf16Avx2(const uint16_t *a, const float *b, const long n)
+{
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_fmadd_ps(loadBf16Avx2(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(loadBf16Avx2(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_fmadd_ps(loadBf16Avx2(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    return sumLanesAvx2(_mm256_add_ps(acc0, acc1)) + dotBf16Generic(a + i, b + i, n - i);
+}
+
+/**
+ * fp16 to float conversion for F16C
+ */
+__attribute__((target("avx2,f16c")))
+static void fp16ToFloatAvx2(const uint16_t *values, float *out, const long n)
+{
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (values + i))));
+    }
+    fp16ToFloatGeneric(values + i, out + i, n - i);
+}
+
+/**
+ * bf16 to float conversion for AVX2
+ */
+__attribute__((target("avx2")))
+static void bf16ToFloatAvx2(const uint16_t *values, float *out, const long n)
+{
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, loadBf16Avx2(values + i));
+    }
+    bf16ToFloatGeneric(values + i, out + i, n - i);
+}
+
+/**
+ * sums the 16 lanes of an AVX-512 register
+ */
+__attribute__((target("avx512f")))
+static float sumLanesAvx512(const __m512 acc)
+{
+    float lanes[16];
+    _mm512_storeu_ps(lanes, acc);
+    float result = 0;
+    for (int lane = 0; lane < 16; lane++)
+    {
+        result += lanes[lane];
+    }
+    return result;
+}
+
+/**
+ * loads up to 16 bf16 values as floats, lanes past n are zero
+ */
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static inline __m512 loadBf16Avx512(const uint16_t *values, const __mmask16 mask)
+{
+    const __m512i widened = _mm512_maskz_cvtepu16_epi32(0xFFFF, _mm256_maskz_loadu_epi16(mask, values));
+    return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, widened, 16));
+}
+
+/**
+ * fp16 dot product for AVX-512, the tail is handled with a masked load
+ */
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static float dotFp16Avx512(const uint16_t *a, const float *b, const long n)
+{
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm512_fmadd_ps(_mm512_maskz_cvtph_ps(0xFFFF, _mm256_loadu_si256((const __m256i *) (a + i))),
+                               _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_cvtph_ps(0xFFFF, _mm256_loadu_si256((const __m256i *) (a + i + 16))),
+                               _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i < n; i += 16)
+    {
+        const __mmask16 mask = n - i >= 16 ? (__mmask16) 0xffff : (__mmask16) ((1u << (n - i)) - 1);
+        acc0 = _mm512_fmadd_ps(_mm512_maskz_cvtph_ps(0xFFFF, _mm256_maskz_loadu_epi16(mask, a + i)),
+                               _mm512_maskz_loadu_ps(mask, b + i), acc0);
+    }
+    return sumLanesAvx512(_mm512_add_ps(acc0, acc1));
+}
+
+/**
+ * bf16 dot product for AVX-512, the tail is handled with a masked load
+ */
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+static float dotBf16Avx512(const uint16_t *a, const float *b, const long n)
+{
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm512_fmadd_ps(loadBf16Avx512(a + i, 0xffff), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(loadBf16Avx512(a + i + 16, 0xffff), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i < n; i += 16)
+    {
+        const __mmask16 mask = n - i >= 16 ? (__mmask16) 0xffff : (__mmask16) ((1u << (n - i)) - 1);
+        acc0 = _mm512_fmadd_ps(loadBf16Avx512(a + i, mask), _mm512_maskz_loadu_ps(mask, b + i), acc0);
+    }
+    return sumLanesAvx512(_mm512_add_ps(acc0, acc1));
+}
+
+#endif
+
+/**
+ * @struct HalfKernels
+ * @brief the kernels of one 16 bit format chosen for the host cpu
+ */
+typedef struct HalfKernels
+{
+    DotHalfFunc dot;
+    ToFloatFunc toFloat;
+} HalfKernels;
+
+/**
+ * picks the widest kernels the host cpu supports for the given format
+ * @param format storage format
+ * @return the chosen kernels
+ */
+static HalfKernels selectHalfKernels(const HalfFormat format)
+{
+    HalfKernels kernels = {format == Fp16Format ? dotFp16Generic : dotBf16Generic,
+                           format == Fp16Format ? fp16ToFloatGeneric : bf16ToFloatGeneric};
+#ifdef HALF_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+        (format == Bf16Format || __builtin_cpu_supports("f16c")))
+    {
+        kernels.dot = format == Fp16Format ? dotFp16Avx2 : dotBf16Avx2;
+        kernels.toFloat = format == Fp16Format ? fp16ToFloatAvx2 : bf16ToFloatAvx2;
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl"))
+    {
+        kernels.dot = format == Fp16Format ? dotFp16Avx512 : dotBf16Avx512;
+    }
+#endif
+    return kernels;
+}
+
+/**
+ * returns the kernels of the given format, chosen once per format on the first call
+ * @param format storage format
+ * @return the kernels
+ */
+static const HalfKernels &halfKernels(const HalfFormat format)
+{
+    static const HalfKernels fp16Kernels = selectHalfKernels(Fp16Format);
+    static const HalfKernels bf16Kernels = selectHalfKernels(Bf16Format);
+    return format == Fp16Format ? fp16Kernels : bf16Kernels;
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * converts a float to the given 16 bit format, rounding to nearest even (values too large for fp16 become infinity)
+ * @param value float to convert
+ * @param format storage format
+ * @return the 16 bit value
+ */
+uint16_t floatToHalf(const float value, const HalfFormat format)
+{
+    return format == Fp16Format ? floatToFp16(value) : floatToBf16(value);
+}
+
+/**
+ * converts a 16 bit value of the given format to float (exact)
+ * @param value 16 bit value to convert
+ * @param format storage format
+ * @return the float value
+ */
+float halfToFloat(const uint16_t value, const HalfFormat format)
+{
+    return format == Fp16Format ? fp16ToFloat(value) : bf16ToFloat(value);
+}
+
+/**
+ * converts n floats to the given 16 bit format
+ * @param values floats to convert
+ * @param out output buffer of n 16 bit values
+ * @param n number of values
+ * @param format storage format
+ */
+void convertToHalf(const float *values, uint16_t *out, const long n, const HalfFormat format)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = floatToHalf(values[i], format);
+    }
+}
+
+/**
+ * converts n 16 bit values of the given format to floats, with F16C / AVX-512 when the host cpu supports it
+ * @param values 16 bit values to convert
+ * @param out output buffer of n floats
+ * @param n number of values
+ * @param format storage format
+ */
+void convertToFloat(const uint16_t *values, float *out, const long n, const HalfFormat format)
+{
+    halfKernels(format).toFloat(values, out, n);
+}
+
+/**
+ * dot product of a vector stored in the given 16 bit format and a float vector. the 16 bit values are converted to
+ * float in registers and accumulated in float.
+ * @param a 16 bit vector of n values
+ * @param b float vector of n values
+ * @param n number of values
+ * @param format storage format of a
+ * @return the dot product
+ */
+float dotHalf(const uint16_t *a, const float *b, const long n, const HalfFormat format)
+{
+    return halfKernels(format).dot(a, b, n);
+}
+
+/**
+ * returns a printable name of the given format
+ * @param format storage format
+ * @return format's name
+ */
+const char *halfFormatName(const HalfFormat format)
+{
+    return format == Fp16Format ? "fp16" : "bf16";
+}
@@ -0,0 +1,79 @@
+// HalfFloat.h
+/**
+ * @file HalfFloat.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief 16 bit floating point storage formats (IEEE half, bfloat16): conversions and float accumulating kernels.
+ */
+
+#ifndef HALFFLOAT_H
+#define HALFFLOAT_H
+
+#include <cstdint>
+
+/**
+ * @enum HalfFormat
+ * @brief 16 bit storage format of a float value.
+ * Fp16Format - IEEE 754 half: 5 exponent bits, 10 mantissa bits (range +-65504).
+ * Bf16Format - bfloat16: the upper 16 bits of a float (float's range, 7 mantissa bits).
+ */
+enum HalfFormat
+{
+    Fp16Format,
+    Bf16Format
+};
+
+/**
+ * converts a float to the given 16 bit format, rounding to nearest even (values too large for fp16 become infinity)
+ * @param value float to convert
+ * @param format storage format
+ * @return the 16 bit value
+ */
+uint16_t floatToHalf(float value, HalfFormat format);
+
+/**
+ * converts a 16 bit value of the given format to float (exact)
+ * @param value 16 bit value to convert
+ * @param format storage format
+ * @return the float value
+ */
+float halfToFloat(uint16_t value, HalfFormat format);
+
+/**
+ * converts n floats to the given 16 bit format
+ * @param values floats to convert
+ * @param out output buffer of n 16 bit values
+ * @param n number of values
+ * @param format storage format
+ */
+void convertToHalf(const float *values, uint16_t *out, long n, HalfFormat format);
+
+/**
+ * converts n 16 bit values of the given format to floats, with F16C / AVX-512 when the host cpu supports it
+ * @param values 16 bit values to convert
+ * @param out output buffer of n floats
+ * @param n number of values
+ * @param format storage format
+ */
+void convertToFloat(const uint16_t *values, float *out, long n, HalfFormat format);
+
+/**
+ * dot product of a vector stored in the given 16 bit format and a float vector. the 16 bit values are converted to
+ * float in registers and accumulated in float.
+ * @param a 16 bit vector of n values
+ * @param b float vector of n values
+ * @param n number of values
+ * @param format storage format of a
+ * @return the dot product
+ */
+float dotHalf(const uint16_t *a, const float *b, long n, HalfFormat format);
+
+/**
+ * returns a printable name of the given format
+ * @param format storage format
+ * @return format's name
+ */
+const char *halfFormatName(HalfFormat format);
+
+#endif //HALFFLOAT_H
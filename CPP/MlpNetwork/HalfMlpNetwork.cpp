@@ -0,0 +1,85 @@
+/**
+ * @file HalfMlpNetwork.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief HalfMlpNetwork object class - MlpNetwork with weights stored in fp16 or bf16
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include "HalfMlpNetwork.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for HalfMlpNetwork object of the default topology: checks the given matrices' dimensions as
+ * MlpNetwork does and converts the weights and biases of every layer to the given format.
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ * @param format 16 bit storage format
+ */
+HalfMlpNetwork::HalfMlpNetwork(Matrix weights[], Matrix biases[], HalfFormat format) :
+        HalfMlpNetwork(defaultLayerSpecs(weights, biases), format)
+{
+}
+
+/**
+ * constructor for HalfMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build()) and
+ * converts the weights and biases of every planned layer to the given format. exits with an error message if the
+ * layers' dimensions don't match.
+ * @param specs network's layers, in order
+ * @param format 16 bit storage format
+ */
+HalfMlpNetwork::HalfMlpNetwork(std::vector<LayerSpec> specs, HalfFormat format) : plan(NetworkPlan::build(specs))
+{
+    layers.reserve(specs.size());
+    for (const LayerSpec &spec : specs)
+    {
+        layers.emplace_back(spec.weights, spec.bias, spec.activation, format);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the network's plan
+ * @return network's plan
+ */
+const NetworkPlan &HalfMlpNetwork::getPlan() const
+{
+    return this->plan;
+}
+
+/**
+ * overloading operator "()" for HalfMlpNetwork object: returns a Digit object presents what digit is described on
+ * given matrix presenting an image and at what probability.
+ * @param img given matrix presents an image describing a digit
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit HalfMlpNetwork::operator()(const Matrix &img) const
+{
+    static thread_local MlpWorkspace workspace;
+    return (*this)(img, workspace);
+}
+
+/**
+ * overloading operator "()" for HalfMlpNetwork object with a caller provided workspace (see MlpNetwork).
+ * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit HalfMlpNetwork::operator()(const Matrix &img, MlpWorkspace &workspace) const
+{
+    return classifyWithPlan(plan, layers, img, workspace);
+}
+
+/**
+ * classifies a batch of images in one forward pass (see MlpNetwork::classifyBatch).
+ * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> HalfMlpNetwork::classifyBatch(const Matrix &images) const
+{
+    return classifyBatchWithPlan(plan, layers, images);
+}
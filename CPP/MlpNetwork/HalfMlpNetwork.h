@@ -0,0 +1,76 @@
+// HalfMlpNetwork.h
+/**
+ * @file HalfMlpNetwork.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief HalfMlpNetwork object class - MlpNetwork with weights stored in fp16 or bf16
+ */
+
+#ifndef HALFMLPNETWORK_H
+#define HALFMLPNETWORK_H
+
+#include "MlpNetwork.h"
+#include "HalfDense.h"
+
+/**
+ * class of HalfMlpNetwork object: any sequence of layers, planned and run as MlpNetwork runs it's layers (see
+ * NetworkPlan.h). every layer is a HalfDense converted from the float weights when the network is constructed.
+ */
+class HalfMlpNetwork : public DigitClassifier
+{
+private:
+    std::vector<HalfDense> layers;
+    NetworkPlan plan;
+public:
+    /**
+     * constructor for HalfMlpNetwork object of the default topology: checks the given matrices' dimensions as
+     * MlpNetwork does and converts the weights and biases of every layer to the given format.
+     * @param weights array of MLP_SIZE matrices representing weights
+     * @param biases array of MLP_SIZE matrices representing biases
+     * @param format 16 bit storage format
+     */
+    HalfMlpNetwork(Matrix weights[], Matrix biases[], HalfFormat format);
+
+    /**
+     * constructor for HalfMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build()) and
+     * converts the weights and biases of every planned layer to the given format. exits with an error message if the
+     * layers' dimensions don't match.
+     * @param specs network's layers, in order
+     * @param format 16 bit storage format
+     */
+    HalfMlpNetwork(std::vector<LayerSpec> specs, HalfFormat format);
+
+    /**
+     * getter for the network's plan
+     * @return network's plan
+     */
+    const NetworkPlan &getPlan() const;
+
+    /**
+     * overloading operator "()" for HalfMlpNetwork object: returns a Digit object presents what digit is described on
+     * given matrix presenting an image and at what probability.
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * overloading operator "()" for HalfMlpNetwork object with a caller provided workspace (see MlpNetwork).
+     * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+     * @param workspace workspace to hold the intermediate results
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img, MlpWorkspace &workspace) const;
+
+    /**
+     * classifies a batch of images in one forward pass (see MlpNetwork::classifyBatch).
+     * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    std::vector<Digit> classifyBatch(const Matrix &images) const override;
+};
+
+#endif //HALFMLPNETWORK_H
@@ -0,0 +1,677 @@
+/**
+ * @file LazyMatrix.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief LazyMatrix object class - opt-in lazy mode of Matrix arithmetic, which records a graph of operations and
+ * optimizes it as a whole before running it.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "LazyMatrix.h"
+#include "Gemm.h"
+#include "SimdKernels.h"
+
+// ------------------------------ recorded graph -----------------------------
+
+/**
+ * @enum LazyOp
+ * @brief operation of a graph node.
+ * LeafOp - a matrix's values.
+ * ScaleOp - scalar * operands[0].
+ * SumOp - sum of the operands.
+ * ProductOp - matrix product of the operands, in order.
+ */
+enum LazyOp
+{
+    LeafOp,
+    ScaleOp,
+    SumOp,
+    ProductOp
+};
+
+/**
+ * @struct LazyNode
+ * @brief node of a recorded graph, as written by the user: sums and products are binary, scalars are where they were
+ * written. a leaf holds the matrix it reads, or only points at it (owned is empty).
+ */
+struct LazyNode
+{
+    LazyOp op;
+    int rows, cols;
+    float scalar;
+    std::vector<std::shared_ptr<const LazyNode>> operands;
+    const float *data;
+    int leadingDim;
+    std::shared_ptr<const Matrix> owned;
+};
+
+/**
+ * @struct PlanNode
+ * @brief node of an optimized graph. operands are indices of earlier nodes, so the nodes are in topological order.
+ * scales are never nested and never scale a product's operand, sums have two terms or more and are never nested,
+ * and products are binary (a chain is a tree of binary products in it's optimal order).
+ */
+typedef struct PlanNode
+{
+    LazyOp op;
+    int rows, cols;
+    float scalar;
+    std::vector<int> operands;
+    const float *data;
+    int leadingDim;
+} PlanNode;
+
+/**
+ * structural key of a PlanNode, equal for nodes computing the same values: operation, scalar's bits, dimensions,
+ * leaf's buffer and leading dimension, and operands
+ */
+typedef std::tuple<int, uint32_t, int, int, const float *, int, std::vector<int>> PlanKey;
+
+/**
+ * class of LazyPlan object: the optimized graph of a recorded expression, and how to run it. built by
+ * materialize(), describe() and getMultiplyAdds() and dropped right after.
+ */
+class LazyPlan
+{
+private:
+    std::vector<PlanNode> nodes;
+    std::map<PlanKey, int> interned;
+    std::unordered_map<const LazyNode *, int> normalized;
+    std::vector<int> uses;
+    std::vector<std::unique_ptr<Matrix>> shared;
+    int root;
+
+    /**
+     * returns the index of a node, adding it unless an equal node was already added (common-subexpression
+     * elimination)
+     * @param node node to add
+     * @return index of the node
+     */
+    int intern(const PlanNode &node)
+    {
+        uint32_t scalarBits;
+        std::memcpy(&scalarBits, &node.scalar, sizeof(scalarBits));
+        const PlanKey key(node.op, scalarBits, node.rows, node.cols, node.data, node.leadingDim, node.operands);
+        const auto found = interned.find(key);
+        if (found != interned.end())
+        {
+            return found->second;
+        }
+        nodes.push_back(node);
+        interned.emplace(key, (int) nodes.size() - 1);
+        return (int) nodes.size() - 1;
+    }
+
+    /**
+     * returns the index of scalar * node, folding the scalar into the node's own scale
+     * @param scalar scalar to multiply with
+     * @param operand index of the node to scale
+     * @return index of the scaled node
+     */
+    int scaled(float scalar, int operand)
+    {
+        if (nodes[operand].op == ScaleOp)
+        {
+            scalar *= nodes[operand].scalar;
+            operand = nodes[operand].operands[0];
+        }
+        if (scalar == 1.0f)
+        {
+            return operand;
+        }
+        return intern({ScaleOp, nodes[operand].rows, nodes[operand].cols, scalar, {operand}, nullptr, 0});
+    }
+
+    /**
+     * collects the terms of a recorded sum, through nested sums and scales, as (coefficient, node) pairs
+     * @param node recorded node
+     * @param coefficient scalar the node is multiplied with
+     * @param terms output, the terms
+     */
+    void collectTerms(const LazyNode &node, const float coefficient, std::vector<std::pair<float, int>> &terms)
+    {
+        if (node.op == SumOp)
+        {
+            collectTerms(*node.operands[0], coefficient, terms);
+            collectTerms(*node.operands[1], coefficient, terms);
+            return;
+        }
+        if (node.op == ScaleOp)
+        {
+            collectTerms(*node.operands[0], coefficient * node.scalar, terms);
+            return;
+        }
+        const int term = normalize(node);
+        if (nodes[term].op == ScaleOp)
+        {
+            terms.emplace_back(coefficient * nodes[term].scalar, nodes[term].operands[0]);
+            return;
+        }
+        terms.emplace_back(coefficient, term);
+    }
+
+    /**
+     * collects the factors of a recorded product chain, through nested products and scales
+     * @param node recorded node
+     * @param scalar output, multiplied by the scalars found in the chain
+     * @param factors output, the chain's factors in order
+     */
+    void collectFactors(const LazyNode &node, float &scalar, std::vector<int> &factors)
+    {
+        if (node.op == ProductOp)
+        {
+            collectFactors(*node.operands[0], scalar, factors);
+            collectFactors(*node.operands[1], scalar, factors);
+            return;
+        }
+        if (node.op == ScaleOp)
+        {
+            scalar *= node.scalar;
+            collectFactors(*node.operands[0], scalar, factors);
+            return;
+        }
+        int factor = normalize(node);
+        if (nodes[factor].op == ScaleOp)
+        {
+            scalar *= nodes[factor].scalar;
+            factor = nodes[factor].operands[0];
+        }
+        factors.push_back(factor);
+    }
+
+    /**
+     * builds the product of factors[first..last] in the order picked by the chain's dynamic program
+     * @param factors chain's factors
+     * @param split split[i][j] is the factor the optimal product of factors[i..j] is split after
+     * @param first first factor
+     * @param last last factor
+     * @return index of the product's node
+     */
+    int orderedProduct(const std::vector<int> &factors, const std::vector<std::vector<int>> &split, const int first,
+                       const int last)
+    {
+        if (first == last)
+        {
+            return factors[first];
+        }
+        const int left = orderedProduct(factors, split, first, split[first][last]);
+        const int right = orderedProduct(factors, split, split[first][last] + 1, last);
+        return intern({ProductOp, nodes[left].rows, nodes[right].cols, 0.0f, {left, right}, nullptr, 0});
+    }
+
+    /**
+     * returns the index of the optimal product of a chain: cost[i][j] is the fewest multiply-adds computing
+     * factors[i..j] takes, cost[i][j] = min over s of cost[i][s] + cost[s+1][j] + rows_i * cols_s * cols_j
+     * @param factors chain's factors, at least two
+     * @return index of the product's node
+     */
+    int chainProduct(const std::vector<int> &factors)
+    {
+        const int n = (int) factors.size();
+        std::vector<std::vector<double>> cost(n, std::vector<double>(n, 0.0));
+        std::vector<std::vector<int>> split(n, std::vector<int>(n, 0));
+        for (int length = 2; length <= n; length++)
+        {
+            for (int i = 0; i + length - 1 < n; i++)
+            {
+                const int j = i + length - 1;
+                cost[i][j] = -1.0;
+                for (int s = i; s < j; s++)
+                {
+                    const double candidate = cost[i][s] + cost[s + 1][j] + (double) nodes[factors[i]].rows *
+                                                                           nodes[factors[s]].cols *
+                                                                           nodes[factors[j]].cols;
+                    if (cost[i][j] < 0 || candidate < cost[i][j])
+                    {
+                        cost[i][j] = candidate;
+                        split[i][j] = s;
+                    }
+                }
+            }
+        }
+        return orderedProduct(factors, split, 0, n - 1);
+    }
+
+    /**
+     * returns the index of the optimized node of a recorded node (every recorded node is optimized once, however
+     * many nodes share it)
+     * @param node recorded node
+     * @return index of the optimized node
+     */
+    int normalize(const LazyNode &node)
+    {
+        const auto found = normalized.find(&node);
+        if (found != normalized.end())
+        {
+            return found->second;
+        }
+        int index;
+        if (node.op == LeafOp)
+        {
+            index = intern({LeafOp, node.rows, node.cols, 0.0f, {}, node.data, node.leadingDim});
+        }
+        else if (node.op == ScaleOp)
+        {
+            index = scaled(node.scalar, normalize(*node.operands[0]));
+        }
+        else if (node.op == SumOp)
+        {
+            std::vector<std::pair<float, int>> terms;
+            collectTerms(node, 1.0f, terms);
+            // equal terms are merged and the terms are sorted, so a + b and b + a are the same node
+            std::sort(terms.begin(), terms.end(), [](const std::pair<float, int> &a, const std::pair<float, int> &b)
+            {
+                return a.second < b.second;
+            });
+            std::vector<int> operands;
+            for (size_t i = 0; i < terms.size(); i++)
+            {
+                float coefficient = terms[i].first;
+                while (i + 1 < terms.size() && terms[i + 1].second == terms[i].second)
+                {
+                    coefficient += terms[++i].first;
+                }
+                operands.push_back(scaled(coefficient, terms[i].second));
+            }
+            index = operands.size() == 1 ? operands[0] :
+                    intern({SumOp, node.rows, node.cols, 0.0f, operands, nullptr, 0});
+        }
+        else
+        {
+            float scalar = 1.0f;
+            std::vector<int> factors;
+            collectFactors(node, scalar, factors);
+            index = scaled(scalar, chainProduct(factors));
+        }
+        normalized.emplace(&node, index);
+        return index;
+    }
+
+    /**
+     * writes (or adds) alpha * a node into a buffer of rows * cols floats stored row after row
+     * @param index node's index
+     * @param dst destination buffer
+     * @param alpha scalar to multiply the values with
+     * @param accumulate true to add to dst, false to overwrite it
+     */
+    void run(const int index, float *dst, const float alpha, const bool accumulate) const
+    {
+        const PlanNode &node = nodes[index];
+        if (node.op == LeafOp || shared[index])
+        {
+            const float *values = node.op == LeafOp ? node.data : shared[index]->getData();
+            const int leadingDim = node.op == LeafOp ? node.leadingDim : node.cols;
+            for (int i = 0; i < node.rows; i++)
+            {
+                const float *row = values + (long) i * leadingDim;
+                float *dstRow = dst + (long) i * node.cols;
+                if (accumulate)
+                {
+                    simdKernels().axpy(alpha, row, dstRow, node.cols);
+                }
+                else
+                {
+                    simdKernels().scale(row, alpha, dstRow, node.cols);
+                }
+            }
+        }
+        else if (node.op == ScaleOp)
+        {
+            run(node.operands[0], dst, alpha * node.scalar, accumulate);
+        }
+        else if (node.op == SumOp)
+        {
+            for (size_t i = 0; i < node.operands.size(); i++)
+            {
+                run(node.operands[i], dst, alpha, accumulate || i > 0);
+            }
+        }
+        else
+        {
+            std::unique_ptr<Matrix> leftValues, rightValues;
+            int lda, ldb;
+            const float *a = operand(node.operands[0], leftValues, lda);
+            const float *b = operand(node.operands[1], rightValues, ldb);
+            gemm(node.rows, node.cols, nodes[node.operands[0]].cols, alpha, a, lda, b, ldb, accumulate ? 1.0f : 0.0f,
+                 dst, node.cols);
+        }
+    }
+
+    /**
+     * returns a product's operand as gemm() reads it: leaves and shared nodes in place, other nodes computed into a
+     * temporary
+     * @param index operand's index
+     * @param values output, the temporary (left empty when the operand is read in place)
+     * @param leadingDim output, operand's leading dimension
+     * @return pointer to the operand's first value
+     */
+    const float *operand(const int index, std::unique_ptr<Matrix> &values, int &leadingDim) const
+    {
+        const PlanNode &node = nodes[index];
+        if (node.op == LeafOp)
+        {
+            leadingDim = node.leadingDim;
+            return node.data;
+        }
+        leadingDim = node.cols;
+        if (shared[index])
+        {
+            return shared[index]->getData();
+        }
+        values.reset(new Matrix(node.rows, node.cols, NoInit));
+        run(index, values->getData(), 1.0f, false);
+        return values->getData();
+    }
+
+    /**
+     * appends a description of a node to a stream: leaves are named m<i>, shared nodes t<i>
+     * @param index node's index
+     * @param names name of every leaf and shared node
+     * @param os stream to write to
+     */
+    void describeNode(const int index, const std::vector<std::string> &names, std::ostream &os) const
+    {
+        const PlanNode &node = nodes[index];
+        if (!names[index].empty())
+        {
+            os << names[index];
+        }
+        else if (node.op == ScaleOp)
+        {
+            os << node.scalar << " * ";
+            describeNode(node.operands[0], names, os);
+        }
+        else
+        {
+            os << "(";
+            for (size_t i = 0; i < node.operands.size(); i++)
+            {
+                os << (i > 0 ? (node.op == SumOp ? " + " : " * ") : "");
+                describeNode(node.operands[i], names, os);
+            }
+            os << ")";
+        }
+    }
+
+public:
+    /**
+     * constructor for LazyPlan object: optimizes a recorded graph and finds the nodes read more than once
+     * @param recorded root of the recorded graph
+     */
+    explicit LazyPlan(const LazyNode &recorded)
+    {
+        root = normalize(recorded);
+        uses.assign(nodes.size(), 0);
+        std::vector<bool> reached(nodes.size(), false);
+        reached[root] = true;
+        // operands come before the nodes reading them, so one pass from the root down reaches every node
+        for (int i = root; i >= 0; i--)
+        {
+            if (reached[i])
+            {
+                for (const int operand : nodes[i].operands)
+                {
+                    uses[operand]++;
+                    reached[operand] = true;
+                }
+            }
+        }
+        shared.resize(nodes.size());
+    }
+
+    /**
+     * computes the optimized graph: the shared nodes first, each into it's own temporary, then the root
+     * @return matrix of the expression's values
+     */
+    Matrix execute()
+    {
+        for (int i = 0; i < root; i++)
+        {
+            if (uses[i] > 1 && nodes[i].op != LeafOp)
+            {
+                std::unique_ptr<Matrix> values(new Matrix(nodes[i].rows, nodes[i].cols, NoInit));
+                run(i, values->getData(), 1.0f, false);
+                shared[i] = std::move(values);
+            }
+        }
+        Matrix result(nodes[root].rows, nodes[root].cols, NoInit);
+        run(root, result.getData(), 1.0f, false);
+        return result;
+    }
+
+    /**
+     * returns a description of the optimized graph (see LazyMatrix::describe())
+     * @return description of the optimized graph
+     */
+    std::string describe() const
+    {
+        std::vector<std::string> names(nodes.size());
+        int leaves = 0, temporaries = 0;
+        std::ostringstream description;
+        for (int i = 0; i <= root; i++)
+        {
+            if (nodes[i].op == LeafOp)
+            {
+                names[i] = "m" + std::to_string(leaves++);
+            }
+            else if (uses[i] > 1)
+            {
+                description << "t" << temporaries << " = ";
+                describeNode(i, names, description);
+                description << "; ";
+                names[i] = "t" + std::to_string(temporaries++);
+            }
+        }
+        description << "result = ";
+        describeNode(root, names, description);
+        return description.str();
+    }
+
+    /**
+     * returns the number of multiply-adds of the products the optimized graph computes (shared ones counted once)
+     * @return number of multiply-adds
+     */
+    double getMultiplyAdds() const
+    {
+        double multiplyAdds = 0;
+        for (int i = 0; i <= root; i++)
+        {
+            if (nodes[i].op == ProductOp && (uses[i] > 0 || i == root))
+            {
+                multiplyAdds += (double) nodes[i].rows * nodes[i].cols * nodes[nodes[i].operands[0]].cols;
+            }
+        }
+        return multiplyAdds;
+    }
+};
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * returns a new recorded leaf
+ * @param data pointer to the leaf's first value
+ * @param rows leaf's number of rows
+ * @param cols leaf's number of columns
+ * @param leadingDim distance between the starts of two consecutive rows
+ * @param owned matrix holding the values, or null if the leaf only points at them
+ * @return the leaf
+ */
+static std::shared_ptr<const LazyNode> recordLeaf(const float *data, const int rows, const int cols,
+                                                  const int leadingDim, std::shared_ptr<const Matrix> owned)
+{
+    return std::make_shared<const LazyNode>(LazyNode{LeafOp, rows, cols, 0.0f, {}, data, leadingDim,
+                                                     std::move(owned)});
+}
+
+/**
+ * returns a new recorded operation
+ * @param op operation
+ * @param rows result's number of rows
+ * @param cols result's number of columns
+ * @param scalar scalar of a ScaleOp
+ * @param operands operation's operands
+ * @return the operation's node
+ */
+static std::shared_ptr<const LazyNode> recordOp(const LazyOp op, const int rows, const int cols, const float scalar,
+                                                std::vector<std::shared_ptr<const LazyNode>> operands)
+{
+    return std::make_shared<const LazyNode>(LazyNode{op, rows, cols, scalar, std::move(operands), nullptr, 0,
+                                                     nullptr});
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for LazyMatrix object holding a recorded node
+ * @param node recorded node
+ */
+LazyMatrix::LazyMatrix(std::shared_ptr<const LazyNode> node) : node(std::move(node))
+{
+}
+
+/**
+ * constructor for LazyMatrix object reading a matrix in place (the matrix must outlive the expression)
+ * @param m matrix to read
+ */
+LazyMatrix::LazyMatrix(const Matrix &m) :
+        node(recordLeaf(m.getData(), m.getRows(), m.getCols(), m.getLeadingDim(), nullptr))
+{
+}
+
+/**
+ * constructor for LazyMatrix object holding a temporary matrix
+ * @param m matrix to take over
+ */
+LazyMatrix::LazyMatrix(Matrix &&m)
+{
+    const std::shared_ptr<const Matrix> owned = std::make_shared<const Matrix>(std::move(m));
+    node = recordLeaf(owned->getData(), owned->getRows(), owned->getCols(), owned->getLeadingDim(), owned);
+}
+
+/**
+ * constructor for LazyMatrix object reading a view's values in place (the viewed buffer must outlive the expression)
+ * @param view view to read
+ */
+LazyMatrix::LazyMatrix(const MatrixView &view) :
+        node(recordLeaf(view.getData(), view.getRows(), view.getCols(), view.getLeadingDim(), nullptr))
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for expression's number of rows
+ * @return expression's number of rows
+ */
+int LazyMatrix::getRows() const
+{
+    return node->rows;
+}
+
+/**
+ * getter for expression's number of columns
+ * @return expression's number of columns
+ */
+int LazyMatrix::getCols() const
+{
+    return node->cols;
+}
+
+/**
+ * optimizes the recorded graph (see LazyPlan) and computes it
+ * @return matrix of the expression's values
+ */
+Matrix LazyMatrix::materialize() const
+{
+    return LazyPlan(*node).execute();
+}
+
+/**
+ * returns a description of the optimized graph
+ * @return description of the optimized graph
+ */
+std::string LazyMatrix::describe() const
+{
+    return LazyPlan(*node).describe();
+}
+
+/**
+ * returns the number of multiply-adds of the products of the optimized graph
+ * @return number of multiply-adds
+ */
+double LazyMatrix::getMultiplyAdds() const
+{
+    return LazyPlan(*node).getMultiplyAdds();
+}
+
+/**
+ * overloading operator "+" for LazyMatrix objects: records a sum
+ * @param a first operand
+ * @param b second operand
+ * @return handle to the recorded sum
+ */
+LazyMatrix operator+(const LazyMatrix &a, const LazyMatrix &b)
+{
+    checkExprSameDims(a, b, "\"+\"");
+    return LazyMatrix(recordOp(SumOp, a.getRows(), a.getCols(), 0.0f, {a.node, b.node}));
+}
+
+/**
+ * overloading operator "-" for LazyMatrix objects: records a difference (a + (-1) * b)
+ * @param a first operand
+ * @param b second operand
+ * @return handle to the recorded difference
+ */
+LazyMatrix operator-(const LazyMatrix &a, const LazyMatrix &b)
+{
+    checkExprSameDims(a, b, "\"-\"");
+    return a + -1.0f * b;
+}
+
+/**
+ * overloading operator "*" for LazyMatrix objects: records a matrix product
+ * @param a left operand
+ * @param b right operand
+ * @return handle to the recorded product
+ */
+LazyMatrix operator*(const LazyMatrix &a, const LazyMatrix &b)
+{
+    if (a.getCols() != b.getRows())
+    {
+        std::cerr << "Error: operator ""*"" cannot multiply matrices - unsuited number of rows or cols " << std::endl;
+        exit(1);
+    }
+    return LazyMatrix(recordOp(ProductOp, a.getRows(), b.getCols(), 0.0f, {a.node, b.node}));
+}
+
+/**
+ * overloading operator "*" for a scalar and a LazyMatrix object: records a scalar multiplication
+ * @param scalar scalar to multiply with
+ * @param a operand
+ * @return handle to the recorded multiplication
+ */
+LazyMatrix operator*(const float scalar, const LazyMatrix &a)
+{
+    return LazyMatrix(recordOp(ScaleOp, a.getRows(), a.getCols(), scalar, {a.node}));
+}
+
+/**
+ * overloading operator "*" for a LazyMatrix object and a scalar: records a scalar multiplication
+ * @param a operand
+ * @param scalar scalar to multiply with
+ * @return handle to the recorded multiplication
+ */
+LazyMatrix operator*(const LazyMatrix &a, const float scalar)
+{
+    return scalar * a;
+}
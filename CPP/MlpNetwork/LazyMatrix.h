@@ -0,0 +1,152 @@
+// LazyMatrix.h
+/**
+ * @file LazyMatrix.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief LazyMatrix object class - opt-in lazy mode of Matrix arithmetic, which records a graph of operations and
+ * optimizes it as a whole before running it.
+ *
+ * @section DESCRIPTION
+ * the expression templates of MatrixExpr.h evaluate one full expression as it's written: a * b * c * v computes
+ * (a * b) first, then ((a * b) * c), then the product with v. a LazyMatrix instead records every "+", "-" and "*" as a
+ * node of a small graph (nodes may be shared by later expressions), and materialize() runs the following passes on
+ * the graph before computing anything:
+ *  - constant folding: nested scalars are multiplied into one (s * (t * a) is (s * t) * a), scalars are pulled out of
+ *    products into gemm()'s alpha, and repeated terms of a sum are merged (a * b + 2 * (a * b) is 3 * (a * b)).
+ *  - common-subexpression elimination: structurally equal nodes (the same operation of the same operands, sums
+ *    compared regardless of the order of their terms) become one node, which is computed once.
+ *  - matrix chain ordering: every chain of products is re-associated by the optimal parenthesization (the classic
+ *    O(n^3) dynamic program over the chain's dimensions), so a * b * c * v runs as a * (b * (c * v)), three
+ *    matrix-vector products instead of two matrix-matrix products.
+ * the optimized graph is then run like an expression template: sums are accumulated into the destination and
+ * products are written by gemm() straight into it, operands are read in place, and only the nodes read more than
+ * once are kept in temporaries.
+ * a LazyMatrix made from a Matrix (or a MatrixView) reads it when materialized, so the matrix must outlive every
+ * expression that uses it. a LazyMatrix made from a temporary matrix keeps the matrix.
+ */
+
+#ifndef LAZYMATRIX_H
+#define LAZYMATRIX_H
+
+#include <memory>
+#include <string>
+#include "Matrix.h"
+
+/**
+ * node of a recorded graph (defined in LazyMatrix.cpp)
+ */
+struct LazyNode;
+
+/**
+ * class of LazyMatrix object: a handle to a node of a recorded graph of matrix operations. copying a handle shares
+ * the node, so an expression may be used by several later expressions.
+ */
+class LazyMatrix
+{
+private:
+    std::shared_ptr<const LazyNode> node;
+
+    /**
+     * constructor for LazyMatrix object holding a recorded node
+     * @param node recorded node
+     */
+    explicit LazyMatrix(std::shared_ptr<const LazyNode> node);
+
+public:
+    /**
+     * constructor for LazyMatrix object reading a matrix in place (the matrix must outlive the expression)
+     * @param m matrix to read
+     */
+    LazyMatrix(const Matrix &m);
+
+    /**
+     * constructor for LazyMatrix object holding a temporary matrix
+     * @param m matrix to take over
+     */
+    LazyMatrix(Matrix &&m);
+
+    /**
+     * constructor for LazyMatrix object reading a view's values in place (the viewed buffer must outlive the
+     * expression)
+     * @param view view to read
+     */
+    LazyMatrix(const MatrixView &view);
+
+    /**
+     * getter for expression's number of rows
+     * @return expression's number of rows
+     */
+    int getRows() const;
+
+    /**
+     * getter for expression's number of columns
+     * @return expression's number of columns
+     */
+    int getCols() const;
+
+    /**
+     * optimizes the recorded graph (constant folding, common-subexpression elimination and matrix chain ordering) and
+     * computes it
+     * @return matrix of the expression's values
+     */
+    Matrix materialize() const;
+
+    /**
+     * returns a description of the optimized graph, e.g. "t0 = (m1 * m2); result = (m0 * t0) + 2 * t0": m<i> are the
+     * recorded matrices and t<i> the nodes computed once and read more than once
+     * @return description of the optimized graph
+     */
+    std::string describe() const;
+
+    /**
+     * returns the number of multiply-adds of the products of the optimized graph, the dominant part of it's cost
+     * @return number of multiply-adds
+     */
+    double getMultiplyAdds() const;
+
+    /**
+     * overloading operator "+" for LazyMatrix objects: records a sum. exits with an error message if the dimensions
+     * differ.
+     * @param a first operand
+     * @param b second operand
+     * @return handle to the recorded sum
+     */
+    friend LazyMatrix operator+(const LazyMatrix &a, const LazyMatrix &b);
+
+    /**
+     * overloading operator "-" for LazyMatrix objects: records a difference (a + (-1) * b). exits with an error
+     * message if the dimensions differ.
+     * @param a first operand
+     * @param b second operand
+     * @return handle to the recorded difference
+     */
+    friend LazyMatrix operator-(const LazyMatrix &a, const LazyMatrix &b);
+
+    /**
+     * overloading operator "*" for LazyMatrix objects: records a matrix product. exits with an error message if
+     * a's number of columns isn't b's number of rows.
+     * @param a left operand
+     * @param b right operand
+     * @return handle to the recorded product
+     */
+    friend LazyMatrix operator*(const LazyMatrix &a, const LazyMatrix &b);
+
+    /**
+     * overloading operator "*" for a scalar and a LazyMatrix object: records a scalar multiplication
+     * @param scalar scalar to multiply with
+     * @param a operand
+     * @return handle to the recorded multiplication
+     */
+    friend LazyMatrix operator*(float scalar, const LazyMatrix &a);
+
+    /**
+     * overloading operator "*" for a LazyMatrix object and a scalar: records a scalar multiplication
+     * @param a operand
+     * @param scalar scalar to multiply with
+     * @return handle to the recorded multiplication
+     */
+    friend LazyMatrix operator*(const LazyMatrix &a, float scalar);
+};
+
+#endif //LAZYMATRIX_H
@@ -12,10 +12,14 @@
 
 // ------------------------------ includes ------------------------------
 
-#include <new>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <utility>
+#include <algorithm>
 #include "Matrix.h"
+#include "Gemm.h"
+#include "SimdKernels.h"
 
 // -------------------------- const definitions -------------------------
 
@@ -24,16 +28,50 @@
 // ------------------------------ private functions - not part of the API -----------------------------
 
 /**
- * function initializes all given matrix elements to 0
- * @param matrix given matrix
- * @param rows matrix's number of rows
+ * function allocates a MATRIX_ALIGNMENT aligned buffer of given number of floats (released with std::free)
+ * @param size number of floats
+ * @return the buffer
+ */
+float *allocateValues(const long size)
+{
+    const size_t bytes = (size * sizeof(float) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    float *values = (float *) std::aligned_alloc(MATRIX_ALIGNMENT, bytes);
+    if (values == nullptr)
+    {
+        std::cerr << "Error: couldn't allocate needed memory" << std::endl;
+        exit(EXIT_CODE);
+    }
+    return values;
+}
+
+/**
+ * function returns the leading dimension of a matrix with given number of columns and layout
  * @param cols matrix's number of columns
+ * @param layout matrix's layout
+ * @return cols, rounded up to MATRIX_VECTOR_WIDTH for padded rows
+ */
+int leadingDimFor(const int cols, const MatrixLayout layout)
+{
+    if (layout == PackedRows)
+    {
+        return cols;
+    }
+    return (cols + MATRIX_VECTOR_WIDTH - 1) / MATRIX_VECTOR_WIDTH * MATRIX_VECTOR_WIDTH;
+}
+
+/**
+ * function exits with an error message if the two given matrices don't have the same number of rows and columns
+ * @param a first matrix
+ * @param b second matrix
+ * @param operatorName name of the operator to print in the error message
  */
-void initMatrixElemsTo0(float *matrix, const int &rows, const int &cols)
+void checkSameDims(const Matrix &a, const Matrix &b, const char *operatorName)
 {
-    for (int i = 0; i < rows * cols; i++)
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
     {
-        matrix[i] = 0;
+        std::cerr << "Error: operator " << operatorName << " cannot be applied on matrices with different number of "
+                                                           "rows or cols " << std::endl;
+        exit(EXIT_CODE);
     }
 }
 
@@ -44,20 +82,36 @@ void initMatrixElemsTo0(float *matrix, const int &rows, const int &cols)
  * @param rows matrix's number of rows
  * @param cols matrix's number of columns
  */
-Matrix::Matrix(const int rows, const int cols) : matrixDims({rows, cols})
+Matrix::Matrix(const int rows, const int cols) : Matrix(rows, cols, ZeroInit)
+{
+}
+
+/**
+ * constructor for matrix object with given number of rows and columns and a storage policy. the buffer is always
+ * MATRIX_ALIGNMENT aligned.
+ * @param rows matrix's number of rows
+ * @param cols matrix's number of columns
+ * @param init whether the values are zeroed or left uninitialized
+ * @param layout whether the rows are packed or padded to MATRIX_VECTOR_WIDTH
+ */
+Matrix::Matrix(const int rows, const int cols, const MatrixInit init, const MatrixLayout layout) :
+        matrixDims({rows, cols}), leadingDim(leadingDimFor(cols, layout)), ownsMatrix(true)
 {
     if (rows <= 0 || cols <= 0)
     {
         std::cerr << "Error: cant build matrix with negative number of rows and columns" << std::endl;
         exit(EXIT_CODE);
     }
-    matrix = new(std::nothrow) float[rows * cols];
-    if (matrix == nullptr)
+    matrix = allocateValues((long) rows * leadingDim);
+    if (init == ZeroInit)
     {
-        std::cerr << "Error: couldn't allocate needed memory" << std::endl;
-        exit(EXIT_CODE);
+        std::memset(matrix, 0, (long) rows * leadingDim * sizeof(float));
+        return;
+    }
+    for (int i = 0; i < rows && leadingDim != cols; i++)
+    {
+        std::memset(matrix + (long) i * leadingDim + cols, 0, (leadingDim - cols) * sizeof(float));
     }
-    initMatrixElemsTo0(matrix, rows, cols);
 }
 
 /**
@@ -68,33 +122,94 @@ Matrix::Matrix() : Matrix(1, 1)
 }
 
 /**
- * copy constructor for matrix object
+ * copy constructor for matrix object. a copy of an empty (moved from) matrix is empty too, and allocates nothing.
  * @param m matrix to construct a new matrix from with identical values
  */
-Matrix::Matrix(const Matrix &m) : matrixDims({m.getRows(), m.getCols()})
+Matrix::Matrix(const Matrix &m) : matrixDims(m.matrixDims), leadingDim(m.leadingDim), ownsMatrix(true)
 {
-    matrix = new(std::nothrow) float[m.getRows() * m.getCols()];
-    if (matrix == nullptr)
-    {
-        std::cerr << "Error: couldn't allocate needed memory" << std::endl;
-        exit(EXIT_CODE);
-    }
-    for (int i = 0; i < matrixDims.rows * matrixDims.cols; i++)
+    const long size = (long) m.getRows() * m.leadingDim;
+    matrix = size == 0 ? nullptr : allocateValues(size);
+    std::copy(m.matrix, m.matrix + size, matrix);
+}
+
+/**
+ * constructor for matrix object with m's values stored in the given layout
+ * @param m matrix to construct a new matrix from with identical values
+ * @param layout layout of the new matrix's rows
+ */
+Matrix::Matrix(const Matrix &m, const MatrixLayout layout) : Matrix(m.getRows(), m.getCols(), NoInit, layout)
+{
+    for (int i = 0; i < matrixDims.rows; i++)
     {
-        matrix[i] = m.matrix[i];
+        std::copy(m.matrix + (long) i * m.leadingDim, m.matrix + (long) i * m.leadingDim + matrixDims.cols,
+                  this->matrix + (long) i * leadingDim);
     }
 }
 
+/**
+ * move constructor for matrix object: takes over the values buffer of m without copying it. m is left as an
+ * empty (0x0) matrix which may only be destructed or assigned to.
+ * @param m matrix to move from
+ */
+Matrix::Matrix(Matrix &&m) noexcept: matrix(m.matrix), matrixDims(m.matrixDims), leadingDim(m.leadingDim),
+                                     ownsMatrix(m.ownsMatrix)
+{
+    m.matrix = nullptr;
+    m.matrixDims = {0, 0};
+    m.leadingDim = 0;
+}
+
 /**
  * destructor for matrix object
  */
 Matrix::~Matrix()
 {
-    delete[]matrix;
+    if (ownsMatrix)
+    {
+        std::free(matrix);
+    }
+}
+
+/**
+ * constructor for a matrix viewing an external values buffer (see view())
+ * @param data external values buffer
+ * @param dims matrix's dimensions
+ */
+Matrix::Matrix(float *data, const MatrixDims dims) : matrix(data), matrixDims(dims), leadingDim(dims.cols),
+                                                     ownsMatrix(false)
+{
 }
 
 // ------------------------------ public functions - part of the API -----------------------------
 
+/**
+ * returns a matrix viewing an external buffer of rows * cols values (stored row after row) instead of owning a
+ * copy of them, e.g. weights in a memory mapped model file. the buffer must outlive the view. copying a view makes
+ * an owning copy, moving it moves the view.
+ * @param data external values buffer
+ * @param rows matrix's number of rows
+ * @param cols matrix's number of columns
+ * @return matrix viewing data
+ */
+Matrix Matrix::view(float *data, const int rows, const int cols)
+{
+    if (rows <= 0 || cols <= 0)
+    {
+        std::cerr << "Error: cant build matrix with negative number of rows and columns" << std::endl;
+        exit(EXIT_CODE);
+    }
+    return Matrix(data, {rows, cols});
+}
+
+/**
+ * returns whether the matrix views an external buffer (see view()) instead of owning it's values
+ * @return true if the matrix is a view
+ */
+bool Matrix::isView() const
+{
+    return !ownsMatrix;
+}
+
 /**
  * getter for matrix's number of rows
  * @return matrix's number of rows
@@ -113,12 +228,48 @@ int Matrix::getCols() const
     return matrixDims.cols;
 }
 
+/**
+ * getter for matrix's leading dimension: distance (in values) between the starts of two consecutive rows in the
+ * buffer. equals cols unless the matrix has padded rows.
+ * @return matrix's leading dimension
+ */
+int Matrix::getLeadingDim() const
+{
+    return leadingDim;
+}
+
+/**
+ * getter for matrix's underlying values buffer (rows rows of getLeadingDim() values, the first cols of each row are
+ * the matrix's values)
+ * @return pointer to the matrix's first value
+ */
+float *Matrix::getData()
+{
+    return matrix;
+}
+
+/**
+ * getter for matrix's underlying values buffer (see getData()) as const
+ * @return const pointer to the matrix's first value
+ */
+const float *Matrix::getData() const
+{
+    return matrix;
+}
+
 /**
  * function turns the matrix object to vector (1 column) without loosing any of the matrix's values
  * @return
  */
 Matrix &Matrix::vectorize()
 {
+    if (leadingDim != matrixDims.cols)
+    {
+        Matrix packed(matrixDims.rows, matrixDims.cols, NoInit);
+        this->copyToPacked(packed.matrix);
+        *this = std::move(packed);
+    }
+    leadingDim = 1;
     matrixDims.rows = matrixDims.rows * matrixDims.cols;
     matrixDims.cols = 1;
     return *this;
@@ -133,7 +284,7 @@ void Matrix::plainPrint() const
     {
         for (int j = 0; j < this->matrixDims.cols; j++)
         {
-            std::cout << this->matrix[(i * matrixDims.cols) + j] << " ";
+            std::cout << this->matrix[(i * leadingDim) + j] << " ";
         }
         std::cout << std::endl;
     }
@@ -141,7 +292,8 @@ void Matrix::plainPrint() const
 
 /**
  * overloading operator "=" for matrix objects : function copy given matrix's values to this matrix and returns a
- * reference to this matrix in order to enable concatenation as expected form operator "="
+ * reference to this matrix in order to enable concatenation as expected form operator "=". assigning an empty
+ * (moved from) matrix releases this matrix's values and allocates nothing.
  * @param m given matrix to copy values from
  * @return reference to this matrix after all m matrix's values were copied to it
  */
@@ -151,108 +303,152 @@ Matrix &Matrix::operator=(const Matrix &m)
     {
         return *this;
     }
-    this->matrixDims.rows = m.getRows();
-    this->matrixDims.cols = m.getCols();
-    delete[] matrix;
-    this->matrix = new(std::nothrow) float[m.getRows() * m.getCols()];
-    if (matrix == nullptr)
-    {
-        std::cerr << "Error: couldn't allocate needed memory" << std::endl;
-        exit(EXIT_CODE);
-    }
-    for (int i = 0; i < this->getRows() * this->getCols(); i++)
+    const long size = (long) m.getRows() * m.leadingDim;
+    if (!ownsMatrix || (long) this->getRows() * this->leadingDim != size)
     {
-        this->matrix[i] = m.matrix[i];
+        if (ownsMatrix)
+        {
+            std::free(matrix);
+        }
+        this->matrix = size == 0 ? nullptr : allocateValues(size);
+        this->ownsMatrix = true;
     }
+    this->matrixDims = m.matrixDims;
+    this->leadingDim = m.leadingDim;
+    std::copy(m.matrix, m.matrix + size, this->matrix);
+    return *this;
+}
+
+/**
+ * overloading move operator "=" for matrix objects : function takes over m's values buffer (no copy is made) and
+ * hands this matrix's old buffer to m, which releases it when destructed.
+ * @param m given matrix to move values from
+ * @return reference to this matrix after m's values were moved to it
+ */
+Matrix &Matrix::operator=(Matrix &&m) noexcept
+{
+    std::swap(this->matrix, m.matrix);
+    std::swap(this->matrixDims, m.matrixDims);
+    std::swap(this->leadingDim, m.leadingDim);
+    std::swap(this->ownsMatrix, m.ownsMatrix);
     return *this;
 }
 
 /**
- * overloading operator "*" for matrix object : function multiply this matrix's values with another given matrix's
- * values and returns a new matrix containing the multiplied values (returns a new matrix made form matrices
- * multiplication of this matrix and another given matrix).
- * @param b given matrix to multiply with this matrix.
- * @return new matrix made form multiplication of this matrix and b given matrix
+ * writes alpha * this matrix into a given buffer of rows * cols floats
+ * @param dst destination buffer
+ * @param alpha scalar to multiply the values with
  */
-Matrix Matrix::operator*(const Matrix &b) const
+void Matrix::evalTo(float *dst, const float alpha) const
 {
-    if (this->matrixDims.cols != b.matrixDims.rows)
+    if (leadingDim != matrixDims.cols)
     {
-        std::cerr << "Error: operator ""*"" cannot multiply matrices - unsuited number of rows or cols " << std::endl;
-        exit(EXIT_CODE);
+        for (int i = 0; i < matrixDims.rows; i++)
+        {
+            simdKernels().scale(this->matrix + (long) i * leadingDim, alpha, dst + (long) i * matrixDims.cols,
+                                matrixDims.cols);
+        }
+        return;
     }
-    int matrixElemIndex = 0;
-    Matrix matrixToReturn(this->getRows(), b.getCols());
-    for (int i = 0; i < this->matrixDims.rows; i++)
+    const long size = (long) this->getRows() * this->getCols();
+    if (alpha == 1.0f)
     {
-        for (int j = 0; j < b.matrixDims.cols; j++)
+        if (dst != this->matrix)
         {
-            float matrixElement = 0;
-            for (int k = 0; k < this->matrixDims.cols; k++)
-            {
-                matrixElement += this->matrix[i * this->matrixDims.cols + k] * b.matrix[j + k * b.matrixDims.cols];
-            }
-            matrixToReturn.matrix[matrixElemIndex] = matrixElement;
-            matrixElemIndex += 1;
+            std::copy(this->matrix, this->matrix + size, dst);
         }
+        return;
     }
-    return matrixToReturn;
+    simdKernels().scale(this->matrix, alpha, dst, size);
 }
 
 /**
- * overloading operator "*" for matrix object: matrix's scalar multiplication from the left
- * @param scalar float to multiply matrix's values with
- * @param matrixToMultiply given matrix to multiply
- * @return new matrix made from scalar multiplication of this matrix and scalar
+ * adds alpha * this matrix to a given buffer of rows * cols floats
+ * @param dst destination buffer
+ * @param alpha scalar to multiply the values with
  */
-Matrix operator*(const float scalar, const Matrix &matrixToMultiply)
+void Matrix::accumulateTo(float *dst, const float alpha) const
 {
-    Matrix matrixToReturn(matrixToMultiply.getRows(), matrixToMultiply.getCols());
-    for (int i = 0; i < matrixToMultiply.getRows(); i++)
+    if (leadingDim != matrixDims.cols)
     {
-        for (int j = 0; j < matrixToMultiply.getCols(); j++)
+        for (int i = 0; i < matrixDims.rows; i++)
         {
-            matrixToReturn.matrix[i * matrixToMultiply.getCols() + j] = scalar *
-                                                                        matrixToMultiply.matrix[
-                                                                                i * matrixToMultiply.getCols() + j];
+            simdKernels().axpy(alpha, this->matrix + (long) i * leadingDim, dst + (long) i * matrixDims.cols,
+                               matrixDims.cols);
         }
+        return;
+    }
+    const long size = (long) this->getRows() * this->getCols();
+    if (alpha == 1.0f)
+    {
+        simdKernels().add(dst, this->matrix, dst, size);
+        return;
     }
-    return matrixToReturn;
+    simdKernels().axpy(alpha, this->matrix, dst, size);
 }
 
 /**
- * overloading operator "*" for matrix object: matrix's scalar multiplication from the right
- * @param scalar float to multiply matrix's values with
- * @param matrixToMultiply given matrix to multiply
- * @return new matrix made from scalar multiplication of this matrix and scalar
+ * copies the matrix's values into a buffer of rows * cols values stored row after row
+ * @param dst destination buffer
  */
-Matrix Matrix::operator*(const float scalar) const
+void Matrix::copyToPacked(float *dst) const
 {
-    return (scalar) * (*this);
+    for (int i = 0; i < matrixDims.rows; i++)
+    {
+        std::copy(this->matrix + (long) i * leadingDim, this->matrix + (long) i * leadingDim + matrixDims.cols,
+                  dst + (long) i * matrixDims.cols);
+    }
 }
 
 /**
- * overloading operator "+" for matrix object: addition of this matrix and another given matrix
- * @param m given matrix to add it's values to this matrix's values
- * @return new matrix whose values are made from addition of this matrix's values and another given matrix's values (m)
+ * copies rows * cols values stored row after row into the matrix's rows
+ * @param src source buffer
  */
-Matrix Matrix::operator+(const Matrix &m) const
+void Matrix::copyFromPacked(const float *src)
 {
-    if (this->matrixDims.cols != m.matrixDims.cols || this->matrixDims.rows != m.matrixDims.rows)
+    for (int i = 0; i < matrixDims.rows; i++)
     {
-        std::cerr << "Error: operator ""+"" cannot add matrices with different number of rows or cols " << std::endl;
-        exit(EXIT_CODE);
+        std::copy(src + (long) i * matrixDims.cols, src + (long) (i + 1) * matrixDims.cols,
+                  this->matrix + (long) i * leadingDim);
     }
-    Matrix matrixToReturn(this->getRows(), this->getCols());
-    for (int i = 0; i < this->getRows(); i++)
-    {
-        for (int j = 0; j < this->getCols(); j++)
-        {
-            matrixToReturn.matrix[i * this->getCols() + j] = this->matrix[i * this->getCols() + j] +
-                                                             m.matrix[i * m.getCols() + j];
-        }
-    }
-    return matrixToReturn;
+}
+
+/**
+ * overloading operator "+" for two temporary matrices: the sum is computed in place in a's buffer
+ * @param a given temporary matrix whose buffer holds the result
+ * @param b given temporary matrix to add to a
+ * @return matrix whose values are made from addition of a's values and b's values
+ */
+Matrix operator+(Matrix &&a, Matrix &&b)
+{
+    a += b;
+    return std::move(a);
+}
+
+/**
+ * overloading operator "*" for a scalar and a temporary matrix: matrix's scalar multiplication from the left,
+ * computed in place in the temporary's buffer.
+ * @param scalar float to multiply matrix's values with
+ * @param a given temporary matrix to multiply
+ * @return matrix made from scalar multiplication of a and scalar
+ */
+Matrix operator*(const float scalar, Matrix &&a)
+{
+    a *= scalar;
+    return std::move(a);
+}
+
+/**
+ * overloading operator "*" for a temporary matrix and a scalar: matrix's scalar multiplication from the right,
+ * computed in place in the temporary's buffer.
+ * @param a given temporary matrix to multiply
+ * @param scalar float to multiply matrix's values with
+ * @return matrix made from scalar multiplication of a and scalar
+ */
+Matrix operator*(Matrix &&a, const float scalar)
+{
+    a *= scalar;
+    return std::move(a);
 }
 
 /**
@@ -265,7 +461,63 @@ Matrix Matrix::operator+(const Matrix &m) const
  */
 Matrix &Matrix::operator+=(const Matrix &m)
 {
-    *this = (*this + m);
+    checkSameDims(*this, m, "\"+=\"");
+    if (this->leadingDim == m.leadingDim)
+    {
+        simdKernels().add(this->matrix, m.matrix, this->matrix, (long) this->getRows() * this->leadingDim);
+        return *this;
+    }
+    for (int i = 0; i < this->getRows(); i++)
+    {
+        float *row = this->matrix + (long) i * this->leadingDim;
+        simdKernels().add(row, m.matrix + (long) i * m.leadingDim, row, this->getCols());
+    }
+    return *this;
+}
+
+/**
+ * overloading operator "-=" for matrix object: subtracts given matrix's values from this matrix's values in place
+ * (no buffer is allocated).
+ * @param m given matrix to subtract it's values from this matrix's values
+ * @return reference to this matrix after m's values were subtracted from it's values
+ */
+Matrix &Matrix::operator-=(const Matrix &m)
+{
+    checkSameDims(*this, m, "\"-=\"");
+    if (this->leadingDim == m.leadingDim)
+    {
+        simdKernels().axpy(-1.0f, m.matrix, this->matrix, (long) this->getRows() * this->leadingDim);
+        return *this;
+    }
+    for (int i = 0; i < this->getRows(); i++)
+    {
+        simdKernels().axpy(-1.0f, m.matrix + (long) i * m.leadingDim, this->matrix + (long) i * this->leadingDim,
+                           this->getCols());
+    }
+    return *this;
+}
+
+/**
+ * overloading operator "*=" for matrix object: multiplies this matrix's values by a scalar in place (no buffer is
+ * allocated).
+ * @param scalar float to multiply matrix's values with
+ * @return reference to this matrix after it's values were multiplied by scalar
+ */
+Matrix &Matrix::operator*=(const float scalar)
+{
+    simdKernels().scale(this->matrix, scalar, this->matrix, (long) this->getRows() * this->leadingDim);
+    return *this;
+}
+
+/**
+ * overloading operator "*=" for matrix object: replaces this matrix with the product of this matrix and m. the
+ * product is written into one new buffer which then replaces this matrix's buffer (no further copy is made).
+ * @param m given matrix to multiply this matrix with from the right
+ * @return reference to this matrix after it was replaced with the product
+ */
+Matrix &Matrix::operator*=(const Matrix &m)
+{
+    *this = (*this) * m;
     return *this;
 }
 
@@ -283,7 +535,7 @@ float &Matrix::operator()(const int i, const int j)
         std::cerr << "Error: operator ""()"" cannot return a matrix element with negative given index" << std::endl;
         exit(EXIT_CODE);
     }
-    int suitedIndex = i * this->matrixDims.cols + j;
+    int suitedIndex = i * this->leadingDim + j;
     return this->matrix[suitedIndex];
 }
 
@@ -302,7 +554,7 @@ float Matrix::operator()(const int i, const int j) const
         std::cerr << "Error: operator ""()"" cannot return a matrix element with negative given index" << std::endl;
         exit(EXIT_CODE);
     }
-    int suitedIndex = i * this->matrixDims.cols + j;
+    int suitedIndex = i * this->leadingDim + j;
     return this->matrix[suitedIndex];
 }
 
@@ -319,7 +571,11 @@ float &Matrix::operator[](const int i)
         std::cerr << "Error: operator ""[]"" cannot return a matrix value with unsuitable given index" << std::endl;
         exit(EXIT_CODE);
     }
-    return this->matrix[i];
+    if (this->leadingDim == this->matrixDims.cols)
+    {
+        return this->matrix[i];
+    }
+    return this->matrix[i / this->matrixDims.cols * this->leadingDim + i % this->matrixDims.cols];
 }
 
 /**
@@ -336,7 +592,11 @@ float Matrix::operator[](const int i) const
         std::cerr << "Error: operator ""[]"" cannot return a matrix value with  unsuitable given index" << std::endl;
         exit(EXIT_CODE);
     }
-    return this->matrix[i];
+    if (this->leadingDim == this->matrixDims.cols)
+    {
+        return this->matrix[i];
+    }
+    return this->matrix[i / this->matrixDims.cols * this->leadingDim + i % this->matrixDims.cols];
 }
 
 /**
@@ -348,17 +608,17 @@ float Matrix::operator[](const int i) const
  */
 std::istream &operator>>(std::istream &istream, Matrix &m)
 {
-    for (int i = 0; i < m.getRows() && istream.good(); i++)
+    // the values are stored row after row, as in the file, so a matrix with packed rows is read in one call
+    if (m.leadingDim == m.getCols())
     {
-        for (int j = 0; j < m.getCols() && istream.good(); j++)
-        {
-            float num = 0;
-            istream.read((char *) &num, sizeof(float));
-            m.matrix[i * m.getCols() + j] = num;
-        }
+        istream.read((char *) m.matrix, (std::streamsize) sizeof(float) * m.getRows() * m.getCols());
+    }
+    for (int i = 0; i < m.getRows() && m.leadingDim != m.getCols(); i++)
+    {
+        istream.read((char *) (m.matrix + (long) i * m.leadingDim), (std::streamsize) sizeof(float) * m.getCols());
     }
-    std::string str;
-    istream.read((char *) &str, sizeof(float));
+    float extraValue = 0;
+    istream.read((char *) &extraValue, sizeof(float));
     if (istream.eof())
     {
         return istream;
@@ -11,6 +11,63 @@
 
 #include <iostream>
 
+/**
+ * base class of every lazily evaluated matrix expression (curiously recurring template pattern): E is the concrete
+ * expression type, which evaluates itself (see MatrixExpr.h for the expression protocol).
+ * @tparam E concrete expression type
+ */
+template<typename E>
+class MatrixExpr
+{
+public:
+    /**
+     * returns this expression as it's concrete type
+     * @return this expression as it's concrete type
+     */
+    const E &derived() const
+    {
+        return static_cast<const E &>(*this);
+    }
+};
+
+/**
+ * @def MATRIX_ALIGNMENT
+ * @brief alignment in bytes of every buffer a Matrix allocates (one cache line, one AVX-512 register)
+ */
+#define MATRIX_ALIGNMENT 64
+
+/**
+ * @def MATRIX_VECTOR_WIDTH
+ * @brief number of floats in MATRIX_ALIGNMENT bytes - padded rows are rounded up to a multiple of it
+ */
+#define MATRIX_VECTOR_WIDTH 16
+
+/**
+ * @enum MatrixInit
+ * @brief how a new matrix's values are initialized.
+ * ZeroInit - all values are 0.
+ * NoInit - values are left uninitialized, for outputs that are about to be overwritten (padding is still 0).
+ */
+enum MatrixInit
+{
+    ZeroInit,
+    NoInit
+};
+
+/**
+ * @enum MatrixLayout
+ * @brief how a matrix's rows are laid out in it's buffer.
+ * PackedRows - rows follow each other, the leading dimension is cols.
+ * PaddedRows - the leading dimension is cols rounded up to MATRIX_VECTOR_WIDTH, so every row starts on a
+ * MATRIX_ALIGNMENT boundary (the padding values are 0). meant for matrices whose rows are read as vectors, such as
+ * a layer's weights.
+ */
+enum MatrixLayout
+{
+    PackedRows,
+    PaddedRows
+};
+
 /**
  * @struct MatrixDims
  * @brief Matrix dimensions container
@@ -23,11 +80,32 @@ typedef struct MatrixDims
 /**
  * class of Matrix object
  */
-class Matrix
+class Matrix : public MatrixExpr<Matrix>
 {
 private:
     float *matrix;
     MatrixDims matrixDims;
+    int leadingDim;
+    bool ownsMatrix;
+
+    /**
+     * copies the matrix's values into a buffer of rows * cols values stored row after row
+     * @param dst destination buffer
+     */
+    void copyToPacked(float *dst) const;
+
+    /**
+     * copies rows * cols values stored row after row into the matrix's rows
+     * @param src source buffer
+     */
+    void copyFromPacked(const float *src);
+
+    /**
+     * constructor for a matrix viewing an external values buffer (see view())
+     * @param data external values buffer
+     * @param dims matrix's dimensions
+     */
+    Matrix(float *data, MatrixDims dims);
 
 public:
     /**
@@ -37,22 +115,63 @@ public:
      */
     Matrix(int rows, int cols);
 
+    /**
+     * constructor for matrix object with given number of rows and columns and a storage policy. the buffer is
+     * always MATRIX_ALIGNMENT aligned.
+     * @param rows matrix's number of rows
+     * @param cols matrix's number of columns
+     * @param init whether the values are zeroed or left uninitialized
+     * @param layout whether the rows are packed or padded to MATRIX_VECTOR_WIDTH
+     */
+    Matrix(int rows, int cols, MatrixInit init, MatrixLayout layout = PackedRows);
+
     /**
      * default constructor for matrix objects, constructs a matrix with 1 row and 1 column
      */
     Matrix();
 
     /**
-     * copy constructor for matrix object
+     * copy constructor for matrix object. a copy of an empty (moved from) matrix is empty too, and allocates nothing.
      * @param m matrix to construct a new matrix from with identical values
      */
     Matrix(const Matrix &m);
 
+    /**
+     * constructor for matrix object with m's values stored in the given layout
+     * @param m matrix to construct a new matrix from with identical values
+     * @param layout layout of the new matrix's rows
+     */
+    Matrix(const Matrix &m, MatrixLayout layout);
+
+    /**
+     * move constructor for matrix object: takes over the values buffer of m without copying it. m is left as an
+     * empty (0x0) matrix which may only be destructed or assigned to.
+     * @param m matrix to move from
+     */
+    Matrix(Matrix &&m) noexcept;
+
     /**
      * destructor for matrix object
      */
     ~Matrix();
 
+    /**
+     * returns a matrix viewing an external buffer of rows * cols values (stored row after row) instead of owning a
+     * copy of them, e.g. weights in a memory mapped model file. the buffer must outlive the view. copying a view
+     * makes an owning copy, moving it moves the view.
+     * @param data external values buffer
+     * @param rows matrix's number of rows
+     * @param cols matrix's number of columns
+     * @return matrix viewing data
+     */
+    static Matrix view(float *data, int rows, int cols);
+
+    /**
+     * returns whether the matrix views an external buffer (see view()) instead of owning it's values
+     * @return true if the matrix is a view
+     */
+    bool isView() const;
+
     /**
      * getter for matrix's number of rows
      * @return matrix's number of rows
@@ -65,6 +184,26 @@ public:
      */
     int getCols() const;
 
+    /**
+     * getter for matrix's leading dimension: distance (in values) between the starts of two consecutive rows in the
+     * buffer. equals cols unless the matrix has padded rows.
+     * @return matrix's leading dimension
+     */
+    int getLeadingDim() const;
+
+    /**
+     * getter for matrix's underlying values buffer (rows rows of getLeadingDim() values, the first cols of each row
+     * are the matrix's values)
+     * @return pointer to the matrix's first value
+     */
+    float *getData();
+
+    /**
+     * getter for matrix's underlying values buffer (see getData()) as const
+     * @return const pointer to the matrix's first value
+     */
+    const float *getData() const;
+
     /**
      * function turns the matrix object to vector (1 column) without loosing any of the matrix's values
      * @return
@@ -78,43 +217,102 @@ public:
 
     /**
      * overloading operator "=" for matrix objects : function copy given matrix's values to this matrix and returns a
-     * reference to this matrix in order to enable concatenation as expected form operator "="
+     * reference to this matrix in order to enable concatenation as expected form operator "=". assigning an empty
+     * (moved from) matrix releases this matrix's values and allocates nothing.
      * @param m given matrix to copy values from
      * @return reference to this matrix after all m matrix's values were copied to it
      */
     Matrix &operator=(const Matrix &m);
 
     /**
-     * overloading operator "*" for matrix object : function multiply this matrix's values with another given matrix's
-     * values and returns a new matrix containing the multiplied values (returns a new matrix made form matrices
-     * multiplication of this matrix and another given matrix).
-     * @param b given matrix to multiply with this matrix.
-     * @return new matrix made form multiplication of this matrix and b given matrix
+     * overloading move operator "=" for matrix objects : function takes over m's values buffer (no copy is made) and
+     * hands this matrix's old buffer to m, which releases it when destructed.
+     * @param m given matrix to move values from
+     * @return reference to this matrix after m's values were moved to it
      */
-    Matrix operator*(const Matrix &m) const;
+    Matrix &operator=(Matrix &&m) noexcept;
 
     /**
-     * overloading operator "*" for matrix object: matrix's scalar multiplication from the right
-     * @param scalar float to multiply matrix's values with
-     * @param matrixToMultiply given matrix to multiply
-     * @return new matrix made from scalar multiplication of this matrix and scalar
+     * constructor for matrix object from a lazily evaluated matrix expression (see MatrixExpr.h): the whole
+     * expression is evaluated in one pass straight into the new matrix's buffer, with no temporaries.
+     * @param expr expression to evaluate
      */
-    Matrix operator*(float scalar) const;
+    template<typename E>
+    Matrix(const MatrixExpr<E> &expr);
 
     /**
-     * overloading operator "*" for matrix object: matrix's scalar multiplication from the left
-     * @param scalar float to multiply matrix's values with
-     * @param matrixToMultiply given matrix to multiply
-     * @return new matrix made from scalar multiplication of this matrix and scalar
+     * overloading operator "=" for matrix objects and a lazily evaluated matrix expression: the expression is
+     * evaluated straight into this matrix's buffer (a new buffer is only allocated when the dimensions change or when
+     * a matrix product in the expression reads this matrix).
+     * @param expr expression to evaluate
+     * @return reference to this matrix after the expression was evaluated into it
      */
-    friend Matrix operator*(float scalar, const Matrix &matrixToMultiply);
+    template<typename E>
+    Matrix &operator=(const MatrixExpr<E> &expr);
 
     /**
-     * overloading operator "+" for matrix object: addition of this matrix and another given matrix
-     * @param m given matrix to add it's values to this matrix's values
-     * @return new matrix whose values are made from addition of this matrix's values and another given matrix's values
+     * overloading operator "+=" for matrix object and a lazily evaluated matrix expression: the expression's values
+     * are accumulated straight into this matrix's buffer.
+     * @param expr expression to add to this matrix
+     * @return reference to this matrix after the expression's values were added to it
+     */
+    template<typename E>
+    Matrix &operator+=(const MatrixExpr<E> &expr);
+
+    /**
+     * overloading operator "-=" for matrix object and a lazily evaluated matrix expression: the expression's values
+     * are subtracted straight from this matrix's buffer.
+     * @param expr expression to subtract from this matrix
+     * @return reference to this matrix after the expression's values were subtracted from it
+     */
+    template<typename E>
+    Matrix &operator-=(const MatrixExpr<E> &expr);
+
+    // ----------------- matrix expression protocol (see MatrixExpr.h) ----------------
+
+    /**
+     * a matrix can be read element by element, so it may be fused into element-wise loops
      */
-    Matrix operator+(const Matrix &m) const;
+    static constexpr bool isElementWise = true;
+
+    /**
+     * returns the matrix's value at a given linear index (row * cols + col) without bounds checking (used by
+     * expression loops)
+     * @param i value index in matrix's data
+     * @return the matrix's value at index i
+     */
+    float elementAt(long i) const
+    {
+        if (leadingDim == matrixDims.cols)
+        {
+            return matrix[i];
+        }
+        return matrix[i / matrixDims.cols * leadingDim + i % matrixDims.cols];
+    }
+
+    /**
+     * writes alpha * this matrix into a given buffer of rows * cols floats
+     * @param dst destination buffer
+     * @param alpha scalar to multiply the values with
+     */
+    void evalTo(float *dst, float alpha) const;
+
+    /**
+     * adds alpha * this matrix to a given buffer of rows * cols floats
+     * @param dst destination buffer
+     * @param alpha scalar to multiply the values with
+     */
+    void accumulateTo(float *dst, float alpha) const;
+
+    /**
+     * checks whether this expression reads a given matrix
+     * @param m matrix to look for
+     * @return true if this matrix is m
+     */
+    bool references(const Matrix &m) const
+    {
+        return this == &m;
+    }
 
     /**
      * overloading operator "+=" for matrix object: addition of this matrix and another given matrix and assignment
@@ -126,6 +324,30 @@ public:
      */
     Matrix &operator+=(const Matrix &m);
 
+    /**
+     * overloading operator "-=" for matrix object: subtracts given matrix's values from this matrix's values in place
+     * (no buffer is allocated).
+     * @param m given matrix to subtract it's values from this matrix's values
+     * @return reference to this matrix after m's values were subtracted from it's values
+     */
+    Matrix &operator-=(const Matrix &m);
+
+    /**
+     * overloading operator "*=" for matrix object: multiplies this matrix's values by a scalar in place (no buffer is
+     * allocated).
+     * @param scalar float to multiply matrix's values with
+     * @return reference to this matrix after it's values were multiplied by scalar
+     */
+    Matrix &operator*=(float scalar);
+
+    /**
+     * overloading operator "*=" for matrix object: replaces this matrix with the product of this matrix and m. the
+     * product is written into one new buffer which then replaces this matrix's buffer (no further copy is made).
+     * @param m given matrix to multiply this matrix with from the right
+     * @return reference to this matrix after it was replaced with the product
+     */
+    Matrix &operator*=(const Matrix &m);
+
     /**
      * overloading operator "()" for matrix object: returns reference to the matrix's value at index (i,j) in order to
      * enable change the value
@@ -181,4 +403,7 @@ public:
     friend std::ostream &operator<<(std::ostream &os, Matrix &m);
 };
 
+#include "MatrixExpr.h"
+#include "MatrixView.h"
+
 #endif //MATRIX_H
@@ -0,0 +1,505 @@
+// MatrixExpr.h
+/**
+ * @file MatrixExpr.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief lazily evaluated matrix expressions (expression templates) for Matrix arithmetic.
+ *
+ * @section DESCRIPTION
+ * Matrix's "+", "-" and "*" operators don't compute anything, they return small expression objects which remember
+ * their operands. the expression is evaluated only when it is assigned to (or used to construct) a Matrix, straight
+ * into the destination's buffer:
+ *  - element-wise chains such as a + b + c or s * a + b are computed in one fused loop.
+ *  - a matrix product is computed by gemm() directly into the destination, and the rest of the expression is
+ *    accumulated on top of it (a * b + c, s * (a * b) + c * d ...), so no temporary is created for the product.
+ * every expression type E implements the following protocol:
+ *  - int getRows() const, int getCols() const
+ *  - static constexpr bool isElementWise - true if the expression can be read element by element
+ *  - float elementAt(long i) const - value at linear index i (only for element-wise expressions)
+ *  - void evalTo(float *dst, float alpha) const - writes alpha * expression into dst
+ *  - void accumulateTo(float *dst, float alpha) const - adds alpha * expression to dst
+ *  - bool references(const Matrix &m) const - true if the expression reads m
+ * expressions hold references to their Matrix operands, so they must be evaluated before the end of the full
+ * expression that created them (don't store them in "auto" variables).
+ * destination buffers always hold packed rows. operands with padded rows are read through their leading dimension,
+ * and a destination matrix with padded rows is assigned through a packed temporary.
+ */
+
+#ifndef MATRIXEXPR_H
+#define MATRIXEXPR_H
+
+// ------------------------------ includes ------------------------------
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include "Matrix.h"
+#include "Gemm.h"
+
+// ------------------------------ expression operands ------------------------------
+
+/**
+ * how an expression stores one of it's operands: matrices are stored by reference, expressions (which are small
+ * objects holding references) are stored by value.
+ * @tparam E operand type
+ */
+template<typename E>
+struct ExprOperand
+{
+    typedef const E type;
+};
+
+/**
+ * matrices are stored by reference inside expressions
+ */
+template<>
+struct ExprOperand<Matrix>
+{
+    typedef const Matrix &type;
+};
+
+/**
+ * operand of a matrix product as gemm() reads it: any expression other than a matrix is first evaluated into a
+ * temporary matrix.
+ * @tparam E operand type
+ */
+template<typename E>
+struct ProductOperand
+{
+    const Matrix values;
+
+    explicit ProductOperand(const E &operand) : values(operand)
+    {
+    }
+
+    const float *data() const
+    {
+        return values.getData();
+    }
+
+    int ld() const
+    {
+        return values.getLeadingDim();
+    }
+};
+
+/**
+ * matrices take part in products in place
+ */
+template<>
+struct ProductOperand<Matrix>
+{
+    const Matrix &values;
+
+    explicit ProductOperand(const Matrix &operand) : values(operand)
+    {
+    }
+
+    const float *data() const
+    {
+        return values.getData();
+    }
+
+    int ld() const
+    {
+        return values.getLeadingDim();
+    }
+};
+
+/**
+ * exits with an error message if the two given expressions don't have the same number of rows and columns
+ * @param a first expression
+ * @param b second expression
+ * @param operatorName name of the operator to print in the error message
+ */
+template<typename L, typename R>
+void checkExprSameDims(const L &a, const R &b, const char *operatorName)
+{
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
+    {
+        std::cerr << "Error: operator " << operatorName << " cannot be applied on matrices with different number of "
+                                                           "rows or cols " << std::endl;
+        exit(1);
+    }
+}
+
+// ------------------------------ expression classes ------------------------------
+
+/**
+ * lazily evaluated sum of two expressions: L + R
+ * @tparam L left operand type
+ * @tparam R right operand type
+ */
+template<typename L, typename R>
+class SumExpr : public MatrixExpr<SumExpr<L, R>>
+{
+private:
+    typename ExprOperand<L>::type left;
+    typename ExprOperand<R>::type right;
+
+public:
+    static constexpr bool isElementWise = L::isElementWise && R::isElementWise;
+
+    /**
+     * constructor for SumExpr object
+     * @param left left operand
+     * @param right right operand
+     */
+    SumExpr(const L &left, const R &right) : left(left), right(right)
+    {
+        checkExprSameDims(left, right, "\"+\"");
+    }
+
+    int getRows() const
+    {
+        return left.getRows();
+    }
+
+    int getCols() const
+    {
+        return left.getCols();
+    }
+
+    float elementAt(const long i) const
+    {
+        return left.elementAt(i) + right.elementAt(i);
+    }
+
+    void evalTo(float *dst, const float alpha) const
+    {
+        if constexpr (isElementWise)
+        {
+            const long size = (long) getRows() * getCols();
+            for (long i = 0; i < size; i++)
+            {
+                dst[i] = alpha * elementAt(i);
+            }
+        }
+        else if constexpr (!L::isElementWise)
+        {
+            left.evalTo(dst, alpha);
+            right.accumulateTo(dst, alpha);
+        }
+        else
+        {
+            right.evalTo(dst, alpha);
+            left.accumulateTo(dst, alpha);
+        }
+    }
+
+    void accumulateTo(float *dst, const float alpha) const
+    {
+        if constexpr (isElementWise)
+        {
+            const long size = (long) getRows() * getCols();
+            for (long i = 0; i < size; i++)
+            {
+                dst[i] += alpha * elementAt(i);
+            }
+        }
+        else
+        {
+            left.accumulateTo(dst, alpha);
+            right.accumulateTo(dst, alpha);
+        }
+    }
+
+    bool references(const Matrix &m) const
+    {
+        return left.references(m) || right.references(m);
+    }
+};
+
+/**
+ * lazily evaluated product of an expression and a scalar: scalar * E
+ * @tparam E operand type
+ */
+template<typename E>
+class ScaledExpr : public MatrixExpr<ScaledExpr<E>>
+{
+private:
+    float scalar;
+    typename ExprOperand<E>::type operand;
+
+public:
+    static constexpr bool isElementWise = E::isElementWise;
+
+    /**
+     * constructor for ScaledExpr object
+     * @param scalar scalar to multiply the operand with
+     * @param operand operand to multiply
+     */
+    ScaledExpr(const float scalar, const E &operand) : scalar(scalar), operand(operand)
+    {
+    }
+
+    int getRows() const
+    {
+        return operand.getRows();
+    }
+
+    int getCols() const
+    {
+        return operand.getCols();
+    }
+
+    float elementAt(const long i) const
+    {
+        return scalar * operand.elementAt(i);
+    }
+
+    void evalTo(float *dst, const float alpha) const
+    {
+        operand.evalTo(dst, alpha * scalar);
+    }
+
+    void accumulateTo(float *dst, const float alpha) const
+    {
+        operand.accumulateTo(dst, alpha * scalar);
+    }
+
+    bool references(const Matrix &m) const
+    {
+        return operand.references(m);
+    }
+};
+
+/**
+ * lazily evaluated matrix product of two expressions: L * R. evaluated by gemm() straight into the destination.
+ * @tparam L left operand type
+ * @tparam R right operand type
+ */
+template<typename L, typename R>
+class ProductExpr : public MatrixExpr<ProductExpr<L, R>>
+{
+private:
+    typename ExprOperand<L>::type left;
+    typename ExprOperand<R>::type right;
+
+    /**
+     * computes dst = alpha * left * right + beta * dst
+     */
+    void gemmTo(float *dst, const float alpha, const float beta) const
+    {
+        const ProductOperand<L> a(left);
+        const ProductOperand<R> b(right);
+        gemm(left.getRows(), right.getCols(), left.getCols(), alpha, a.data(), a.ld(), b.data(), b.ld(), beta, dst,
+             right.getCols());
+    }
+
+public:
+    static constexpr bool isElementWise = false;
+
+    /**
+     * constructor for ProductExpr object
+     * @param left left operand
+     * @param right right operand
+     */
+    ProductExpr(const L &left, const R &right) : left(left), right(right)
+    {
+        if (left.getCols() != right.getRows())
+        {
+            std::cerr << "Error: operator ""*"" cannot multiply matrices - unsuited number of rows or cols "
+                      << std::endl;
+            exit(1);
+        }
+    }
+
+    int getRows() const
+    {
+        return left.getRows();
+    }
+
+    int getCols() const
+    {
+        return right.getCols();
+    }
+
+    void evalTo(float *dst, const float alpha) const
+    {
+        gemmTo(dst, alpha, 0.0f);
+    }
+
+    void accumulateTo(float *dst, const float alpha) const
+    {
+        gemmTo(dst, alpha, 1.0f);
+    }
+
+    bool references(const Matrix &m) const
+    {
+        return left.references(m) || right.references(m);
+    }
+};
+
+// ------------------------------ operators ------------------------------
+
+/**
+ * overloading operator "+" for matrix expressions: returns a lazily evaluated sum
+ */
+template<typename L, typename R>
+SumExpr<L, R> operator+(const MatrixExpr<L> &a, const MatrixExpr<R> &b)
+{
+    return SumExpr<L, R>(a.derived(), b.derived());
+}
+
+/**
+ * overloading operator "-" for matrix expressions: returns a lazily evaluated difference (a + (-1) * b)
+ */
+template<typename L, typename R>
+SumExpr<L, ScaledExpr<R>> operator-(const MatrixExpr<L> &a, const MatrixExpr<R> &b)
+{
+    return SumExpr<L, ScaledExpr<R>>(a.derived(), ScaledExpr<R>(-1.0f, b.derived()));
+}
+
+/**
+ * overloading operator "*" for matrix expressions: returns a lazily evaluated matrix product
+ */
+template<typename L, typename R>
+ProductExpr<L, R> operator*(const MatrixExpr<L> &a, const MatrixExpr<R> &b)
+{
+    return ProductExpr<L, R>(a.derived(), b.derived());
+}
+
+/**
+ * overloading operator "*" for a scalar and a matrix expression: returns a lazily evaluated scalar multiplication
+ */
+template<typename E>
+ScaledExpr<E> operator*(const float scalar, const MatrixExpr<E> &a)
+{
+    return ScaledExpr<E>(scalar, a.derived());
+}
+
+/**
+ * overloading operator "*" for a matrix expression and a scalar: returns a lazily evaluated scalar multiplication
+ */
+template<typename E>
+ScaledExpr<E> operator*(const MatrixExpr<E> &a, const float scalar)
+{
+    return ScaledExpr<E>(scalar, a.derived());
+}
+
+/**
+ * overloading operator "+" for a temporary matrix and an expression: the expression is accumulated in place into
+ * the temporary's buffer, which is moved to the result.
+ */
+template<typename R>
+Matrix operator+(Matrix &&a, const MatrixExpr<R> &b)
+{
+    a += b;
+    return std::move(a);
+}
+
+/**
+ * overloading operator "+" for an expression and a temporary matrix: the expression is accumulated in place into
+ * the temporary's buffer, which is moved to the result.
+ */
+template<typename L>
+Matrix operator+(const MatrixExpr<L> &a, Matrix &&b)
+{
+    b += a;
+    return std::move(b);
+}
+
+/**
+ * overloading operator "-" for a temporary matrix and an expression: the expression is subtracted in place from the
+ * temporary's buffer, which is moved to the result.
+ */
+template<typename R>
+Matrix operator-(Matrix &&a, const MatrixExpr<R> &b)
+{
+    a -= b;
+    return std::move(a);
+}
+
+/**
+ * overloading operator "+" for two temporary matrices: the sum is computed in place in a's buffer
+ */
+Matrix operator+(Matrix &&a, Matrix &&b);
+
+/**
+ * overloading operator "*" for a scalar and a temporary matrix: computed in place in the temporary's buffer
+ */
+Matrix operator*(float scalar, Matrix &&a);
+
+/**
+ * overloading operator "*" for a temporary matrix and a scalar: computed in place in the temporary's buffer
+ */
+Matrix operator*(Matrix &&a, float scalar);
+
+// ------------------------------ Matrix's expression members ------------------------------
+
+/**
+ * constructor for matrix object from a lazily evaluated matrix expression
+ */
+template<typename E>
+Matrix::Matrix(const MatrixExpr<E> &expr) : Matrix(expr.derived().getRows(), expr.derived().getCols(), NoInit)
+{
+    expr.derived().evalTo(this->matrix, 1.0f);
+}
+
+/**
+ * overloading operator "=" for matrix objects and a lazily evaluated matrix expression
+ */
+template<typename E>
+Matrix &Matrix::operator=(const MatrixExpr<E> &expr)
+{
+    const E &e = expr.derived();
+    if (this->leadingDim != this->matrixDims.cols)
+    {
+        // expressions are evaluated into packed rows, then copied into this matrix's padded rows
+        const Matrix packed(expr);
+        if (e.getRows() != this->matrixDims.rows || e.getCols() != this->matrixDims.cols)
+        {
+            *this = Matrix(e.getRows(), e.getCols(), NoInit, PaddedRows);
+        }
+        this->copyFromPacked(packed.matrix);
+        return *this;
+    }
+    const bool resized = e.getRows() != this->matrixDims.rows || e.getCols() != this->matrixDims.cols;
+    if ((!E::isElementWise || resized) && e.references(*this))
+    {
+        // a product can't be written over it's operand, and a resized matrix would free a buffer the expression reads
+        return *this = Matrix(expr);
+    }
+    if (resized)
+    {
+        *this = Matrix(e.getRows(), e.getCols(), NoInit);
+    }
+    e.evalTo(this->matrix, 1.0f);
+    return *this;
+}
+
+/**
+ * overloading operator "+=" for matrix object and a lazily evaluated matrix expression
+ */
+template<typename E>
+Matrix &Matrix::operator+=(const MatrixExpr<E> &expr)
+{
+    const E &e = expr.derived();
+    checkExprSameDims(*this, e, "\"+=\"");
+    if (this->leadingDim != this->matrixDims.cols || (!E::isElementWise && e.references(*this)))
+    {
+        return *this += Matrix(expr);
+    }
+    e.accumulateTo(this->matrix, 1.0f);
+    return *this;
+}
+
+/**
+ * overloading operator "-=" for matrix object and a lazily evaluated matrix expression
+ */
+template<typename E>
+Matrix &Matrix::operator-=(const MatrixExpr<E> &expr)
+{
+    const E &e = expr.derived();
+    checkExprSameDims(*this, e, "\"-=\"");
+    if (this->leadingDim != this->matrixDims.cols || (!E::isElementWise && e.references(*this)))
+    {
+        return *this -= Matrix(expr);
+    }
+    e.accumulateTo(this->matrix, -1.0f);
+    return *this;
+}
+
+#endif //MATRIXEXPR_H
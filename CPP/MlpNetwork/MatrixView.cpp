@@ -0,0 +1,218 @@
+/**
+ * @file MatrixView.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief MatrixView object class - non-owning, read only view of a block of values in a row-major buffer.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include "MatrixView.h"
+#include "SimdKernels.h"
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * returns the address range a block of values spans in it's buffer, from the first value to one past the last one
+ * @param data pointer to the block's first value
+ * @param rows block's number of rows
+ * @param cols block's number of columns
+ * @param leadingDim distance between the starts of two consecutive rows
+ * @param first output, address of the first value
+ * @param last output, address one past the last value
+ */
+static void spannedRange(const float *data, const int rows, const int cols, const int leadingDim,
+                         std::uintptr_t &first, std::uintptr_t &last)
+{
+    first = (std::uintptr_t) data;
+    last = (std::uintptr_t) (data + (long) (rows - 1) * leadingDim + cols);
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for MatrixView object viewing rows x cols values of an external buffer. exits with an error message
+ * if the dimensions are not positive or leadingDim is smaller than cols.
+ * @param data pointer to the first value
+ * @param rows view's number of rows
+ * @param cols view's number of columns
+ * @param leadingDim distance (in values) between the starts of two consecutive rows
+ */
+MatrixView::MatrixView(const float *data, const int rows, const int cols, const int leadingDim) :
+        data(data), rows(rows), cols(cols), leadingDim(leadingDim)
+{
+    if (rows <= 0 || cols <= 0)
+    {
+        std::cerr << "Error: cant build matrix view with negative number of rows and columns" << std::endl;
+        exit(1);
+    }
+    if (leadingDim < cols)
+    {
+        std::cerr << "Error: matrix view's leading dimension is smaller than it's number of columns" << std::endl;
+        exit(1);
+    }
+}
+
+/**
+ * constructor for MatrixView object viewing rows x cols values of an external buffer stored row after row
+ * @param data pointer to the first value
+ * @param rows view's number of rows
+ * @param cols view's number of columns
+ */
+MatrixView::MatrixView(const float *data, const int rows, const int cols) : MatrixView(data, rows, cols, cols)
+{
+}
+
+/**
+ * constructor for MatrixView object viewing all of a matrix's values
+ * @param m matrix to view
+ */
+MatrixView::MatrixView(const Matrix &m) : data(m.getData()), rows(m.getRows()), cols(m.getCols()),
+                                          leadingDim(m.getLeadingDim())
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * returns a view of a block of this view. exits with an error message if the block isn't inside this view.
+ * @param row first row of the block
+ * @param col first column of the block
+ * @param blockRows block's number of rows
+ * @param blockCols block's number of columns
+ * @return view of the block
+ */
+MatrixView MatrixView::block(const int row, const int col, const int blockRows, const int blockCols) const
+{
+    if (row < 0 || col < 0 || blockRows <= 0 || blockCols <= 0 || row + blockRows > rows || col + blockCols > cols)
+    {
+        std::cerr << "Error: matrix view's block is out of the matrix's range" << std::endl;
+        exit(1);
+    }
+    return MatrixView(data + (long) row * leadingDim + col, blockRows, blockCols, leadingDim);
+}
+
+/**
+ * returns a view of consecutive rows of this view (see block())
+ * @param first first row
+ * @param count number of rows
+ * @return view of the rows
+ */
+MatrixView MatrixView::rowRange(const int first, const int count) const
+{
+    return block(first, 0, count, cols);
+}
+
+/**
+ * returns a view of one column of this view (see block())
+ * @param col column index
+ * @return view of the column
+ */
+MatrixView MatrixView::column(const int col) const
+{
+    return block(0, col, rows, 1);
+}
+
+/**
+ * returns a view of this view's values with other dimensions. exits with an error message if the view isn't
+ * contiguous or newRows * newCols isn't it's number of values.
+ * @param newRows new number of rows
+ * @param newCols new number of columns
+ * @return the reshaped view
+ */
+MatrixView MatrixView::reshape(const int newRows, const int newCols) const
+{
+    if (!isContiguous())
+    {
+        std::cerr << "Error: cannot reshape a matrix view whose rows are not contiguous" << std::endl;
+        exit(1);
+    }
+    if ((long) newRows * newCols != (long) rows * cols)
+    {
+        std::cerr << "Error: reshaped matrix view must have the same number of values" << std::endl;
+        exit(1);
+    }
+    return MatrixView(data, newRows, newCols);
+}
+
+/**
+ * overloading operator "()" for MatrixView object: returns the view's value at index (i,j). exits with an error
+ * message if the index is out of range.
+ * @param i row index
+ * @param j column index
+ * @return the view's value at index (i,j)
+ */
+float MatrixView::operator()(const int i, const int j) const
+{
+    if (i < 0 || j < 0 || i >= rows || j >= cols)
+    {
+        std::cerr << "Error: operator ""()"" cannot return a matrix view element out of it's range" << std::endl;
+        exit(1);
+    }
+    return data[(long) i * leadingDim + j];
+}
+
+/**
+ * writes alpha * this view into a given buffer of rows * cols floats
+ * @param dst destination buffer
+ * @param alpha scalar to multiply the values with
+ */
+void MatrixView::evalTo(float *dst, const float alpha) const
+{
+    if (!isContiguous())
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            simdKernels().scale(data + (long) i * leadingDim, alpha, dst + (long) i * cols, cols);
+        }
+        return;
+    }
+    const long size = (long) rows * cols;
+    if (alpha == 1.0f)
+    {
+        if (dst != data)
+        {
+            std::copy(data, data + size, dst);
+        }
+        return;
+    }
+    simdKernels().scale(data, alpha, dst, size);
+}
+
+/**
+ * adds alpha * this view to a given buffer of rows * cols floats
+ * @param dst destination buffer
+ * @param alpha scalar to multiply the values with
+ */
+void MatrixView::accumulateTo(float *dst, const float alpha) const
+{
+    if (!isContiguous())
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            simdKernels().axpy(alpha, data + (long) i * leadingDim, dst + (long) i * cols, cols);
+        }
+        return;
+    }
+    simdKernels().axpy(alpha, data, dst, (long) rows * cols);
+}
+
+/**
+ * checks whether this view reads a given matrix's buffer
+ * @param m matrix to look for
+ * @return true if the viewed values overlap m's buffer
+ */
+bool MatrixView::references(const Matrix &m) const
+{
+    if (m.getRows() <= 0 || m.getCols() <= 0)
+    {
+        return false;
+    }
+    std::uintptr_t first, last, matrixFirst, matrixLast;
+    spannedRange(data, rows, cols, leadingDim, first, last);
+    spannedRange(m.getData(), m.getRows(), m.getCols(), m.getLeadingDim(), matrixFirst, matrixLast);
+    return first < matrixLast && matrixFirst < last;
+}
@@ -0,0 +1,219 @@
+// MatrixView.h
+/**
+ * @file MatrixView.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief MatrixView object class - non-owning, read only view of a block of values in a row-major buffer.
+ *
+ * @section DESCRIPTION
+ * a MatrixView is a pointer, a number of rows and columns and a leading dimension (distance between the starts of
+ * two consecutive rows), so slicing and reshaping a matrix only makes a new view and never copies a value:
+ *  - block(), rowRange() and column() view part of a matrix, e.g. the columns of one image in a batch.
+ *  - reshape() views the values of a packed matrix with other dimensions (what Matrix::vectorize() does in place).
+ *  - a view of an external buffer, such as an mmapped weights file or a buffer owned by the caller's I/O layer, is
+ *    made straight from it's pointer.
+ * a MatrixView is a matrix expression (see MatrixExpr.h), so it may be an operand of Matrix's arithmetic operators,
+ * and is accepted by Dense and Activation; a product reads it in place through it's leading dimension.
+ * the viewed buffer must outlive the view. a view of a matrix may be assigned to that same matrix (e.g. m = a block
+ * of m), it's values are then evaluated into a new buffer first.
+ */
+
+#ifndef MATRIXVIEW_H
+#define MATRIXVIEW_H
+
+#include "Matrix.h"
+
+/**
+ * class of MatrixView object
+ */
+class MatrixView : public MatrixExpr<MatrixView>
+{
+private:
+    const float *data;
+    int rows, cols;
+    int leadingDim;
+
+public:
+    /**
+     * constructor for MatrixView object viewing rows x cols values of an external buffer. exits with an error
+     * message if the dimensions are not positive or leadingDim is smaller than cols.
+     * @param data pointer to the first value
+     * @param rows view's number of rows
+     * @param cols view's number of columns
+     * @param leadingDim distance (in values) between the starts of two consecutive rows
+     */
+    MatrixView(const float *data, int rows, int cols, int leadingDim);
+
+    /**
+     * constructor for MatrixView object viewing rows x cols values of an external buffer stored row after row
+     * @param data pointer to the first value
+     * @param rows view's number of rows
+     * @param cols view's number of columns
+     */
+    MatrixView(const float *data, int rows, int cols);
+
+    /**
+     * constructor for MatrixView object viewing all of a matrix's values (with it's leading dimension, so padded rows
+     * are viewed in place)
+     * @param m matrix to view
+     */
+    MatrixView(const Matrix &m);
+
+    /**
+     * getter for view's number of rows
+     * @return view's number of rows
+     */
+    int getRows() const
+    {
+        return rows;
+    }
+
+    /**
+     * getter for view's number of columns
+     * @return view's number of columns
+     */
+    int getCols() const
+    {
+        return cols;
+    }
+
+    /**
+     * getter for view's leading dimension: distance (in values) between the starts of two consecutive rows
+     * @return view's leading dimension
+     */
+    int getLeadingDim() const
+    {
+        return leadingDim;
+    }
+
+    /**
+     * getter for the viewed buffer
+     * @return pointer to the view's first value
+     */
+    const float *getData() const
+    {
+        return data;
+    }
+
+    /**
+     * returns whether the view's values are stored row after row with no gap (the leading dimension is cols, or
+     * there is a single row)
+     * @return true if the view is contiguous
+     */
+    bool isContiguous() const
+    {
+        return leadingDim == cols || rows == 1;
+    }
+
+    /**
+     * returns a view of a block of this view. exits with an error message if the block isn't inside this view.
+     * @param row first row of the block
+     * @param col first column of the block
+     * @param blockRows block's number of rows
+     * @param blockCols block's number of columns
+     * @return view of the block
+     */
+    MatrixView block(int row, int col, int blockRows, int blockCols) const;
+
+    /**
+     * returns a view of consecutive rows of this view (see block())
+     * @param first first row
+     * @param count number of rows
+     * @return view of the rows
+     */
+    MatrixView rowRange(int first, int count) const;
+
+    /**
+     * returns a view of one column of this view, e.g. one image of a batch whose images are columns (see block())
+     * @param col column index
+     * @return view of the column (a rows x 1 view, strided by this view's leading dimension)
+     */
+    MatrixView column(int col) const;
+
+    /**
+     * returns a view of this view's values with other dimensions. exits with an error message if the view isn't
+     * contiguous or newRows * newCols isn't it's number of values.
+     * @param newRows new number of rows
+     * @param newCols new number of columns
+     * @return the reshaped view
+     */
+    MatrixView reshape(int newRows, int newCols) const;
+
+    /**
+     * overloading operator "()" for MatrixView object: returns the view's value at index (i,j). exits with an error
+     * message if the index is out of range.
+     * @param i row index
+     * @param j column index
+     * @return the view's value at index (i,j)
+     */
+    float operator()(int i, int j) const;
+
+    // ----------------- matrix expression protocol (see MatrixExpr.h) ----------------
+
+    /**
+     * a view can be read element by element, so it may be fused into element-wise loops
+     */
+    static constexpr bool isElementWise = true;
+
+    /**
+     * returns the view's value at a given linear index (row * cols + col) without bounds checking (used by
+     * expression loops)
+     * @param i value index
+     * @return the view's value at index i
+     */
+    float elementAt(const long i) const
+    {
+        if (leadingDim == cols)
+        {
+            return data[i];
+        }
+        return data[i / cols * leadingDim + i % cols];
+    }
+
+    /**
+     * writes alpha * this view into a given buffer of rows * cols floats
+     * @param dst destination buffer
+     * @param alpha scalar to multiply the values with
+     */
+    void evalTo(float *dst, float alpha) const;
+
+    /**
+     * adds alpha * this view to a given buffer of rows * cols floats
+     * @param dst destination buffer
+     * @param alpha scalar to multiply the values with
+     */
+    void accumulateTo(float *dst, float alpha) const;
+
+    /**
+     * checks whether this view reads a given matrix's buffer
+     * @param m matrix to look for
+     * @return true if the viewed values overlap m's buffer
+     */
+    bool references(const Matrix &m) const;
+};
+
+/**
+ * views take part in products in place, through their leading dimension
+ */
+template<>
+struct ProductOperand<MatrixView>
+{
+    const MatrixView values;
+
+    explicit ProductOperand(const MatrixView &operand) : values(operand)
+    {
+    }
+
+    const float *data() const
+    {
+        return values.getData();
+    }
+
+    int ld() const
+    {
+        return values.getLeadingDim();
+    }
+};
+
+#endif //MATRIXVIEW_H
@@ -0,0 +1,387 @@
+/**
+ * @file MlpBench.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief microbenchmarks of the MlpNetwork kernels: matrix products at several shapes, element-wise operations,
+ * every Dense layer of the default topology and full single and batched inference, on random weights. prints a
+ * table of ns/op, p50/p99 latency and GFLOP/s, and optionally writes the same results as JSON for regression
+ * tracking. with -p, the per-layer profile of the run is printed and written as JSON too (see Profiler.h).
+ * before timing anything, Strassen-Winograd's products of padded shapes are checked against the blocked product.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "MlpNetwork.h"
+#include "SimdKernels.h"
+#include "Profiler.h"
+#include "CachedClassifier.h"
+#include "LazyMatrix.h"
+#include "Gemm.h"
+
+// -------------------------- const definitions -------------------------
+
+#define USAGE_MSG "Usage: mlpbench [-o results.json] [-p profile.json] [name_filter]"
+#define MIN_SAMPLE_NS 2000.0
+#define MAX_REPETITIONS (1L << 20)
+#define MIN_BENCH_SECONDS 0.2
+#define MIN_SAMPLES 20
+#define MAX_SAMPLES 100000
+#define BATCH_SIZE 64
+#define LARGE_BATCH_SIZE 256
+#define P50 0.5
+#define P99 0.99
+#define RANDOM_SEED 2019
+#define STRASSEN_CHECK_SIZE 1024
+#define STRASSEN_CHECK_TOLERANCE 1e-2f
+
+/**
+ * @struct BenchResult
+ * @brief result of one benchmark. the latencies are of one operation: when an operation is faster than
+ * MIN_SAMPLE_NS, a sample times several repetitions and the latency is the sample's mean.
+ */
+typedef struct BenchResult
+{
+    std::string name;
+    long operations;
+    double nsPerOp, p50Ns, p99Ns, gflops;
+} BenchResult;
+
+/**
+ * sink every benchmark writes a value of it's result to, so the compiler can't drop the measured work
+ */
+static volatile float sink;
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns the time it takes to run an operation a given number of times, in nanoseconds
+ * @param operation operation to run
+ * @param repetitions number of times to run it
+ * @return time it took in nanoseconds
+ */
+template<typename Operation>
+static double timeRepetitions(const Operation &operation, const long repetitions)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < repetitions; i++)
+    {
+        operation();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * runs one benchmark: finds how many repetitions make a sample last at least MIN_SAMPLE_NS, then takes samples for
+ * at least MIN_BENCH_SECONDS.
+ * @param name benchmark's name
+ * @param flops floating point operations of one operation (0 if not meaningful)
+ * @param operation operation to measure
+ * @return the benchmark's result
+ */
+template<typename Operation>
+static BenchResult runBenchmark(const std::string &name, const double flops, const Operation &operation)
+{
+    long repetitions = 1;
+    while (repetitions < MAX_REPETITIONS && timeRepetitions(operation, repetitions) < MIN_SAMPLE_NS)
+    {
+        repetitions *= 2;
+    }
+    std::vector<double> samples;
+    double totalNs = 0;
+    while (samples.size() < MAX_SAMPLES && (samples.size() < MIN_SAMPLES || totalNs < MIN_BENCH_SECONDS * 1e9))
+    {
+        const double ns = timeRepetitions(operation, repetitions);
+        samples.push_back(ns / (double) repetitions);
+        totalNs += ns;
+    }
+    std::sort(samples.begin(), samples.end());
+    BenchResult result;
+    result.name = name;
+    result.operations = (long) samples.size() * repetitions;
+    result.nsPerOp = totalNs / (double) result.operations;
+    result.p50Ns = samples[(size_t) ((double) (samples.size() - 1) * P50)];
+    result.p99Ns = samples[(size_t) ((double) (samples.size() - 1) * P99)];
+    result.gflops = flops / result.nsPerOp;
+    return result;
+}
+
+/**
+ * returns a matrix of random values in [-1, 1]
+ * @param rows number of rows
+ * @param cols number of columns
+ * @param generator random generator
+ * @return the matrix
+ */
+static Matrix randomMatrix(const int rows, const int cols, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    Matrix matrixToReturn(rows, cols, NoInit);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            matrixToReturn(i, j) = distribution(generator);
+        }
+    }
+    return matrixToReturn;
+}
+
+/**
+ * checks Strassen-Winograd's products (see setGemmPolicy()) against the blocked product, on shapes that need padding
+ * in every one of m, n and k. prints an error message for the first shape that doesn't match.
+ * @param generator random generator
+ * @return true if every product matches
+ */
+static bool checkStrassen(std::mt19937 &generator)
+{
+    const int size = STRASSEN_CHECK_SIZE;
+    const int checkShapes[][3] = {{size, size, size + 1}, {size + 1, size, size}, {size, size + 1, size},
+                                  {size - 1, size + 6, size + 3}};
+    const GemmPolicy policy = getGemmPolicy();
+    bool matches = true;
+    for (const auto &shape : checkShapes)
+    {
+        const Matrix a = randomMatrix(shape[0], shape[1], generator), b = randomMatrix(shape[1], shape[2], generator);
+        setGemmPolicy(GemmBlocked);
+        const Matrix expected = a * b;
+        setGemmPolicy(GemmStrassen);
+        const Matrix product = a * b;
+        float maxError = 0;
+        for (int i = 0; i < shape[0]; i++)
+        {
+            for (int j = 0; j < shape[2]; j++)
+            {
+                maxError = std::max(maxError, std::abs(product(i, j) - expected(i, j)));
+            }
+        }
+        if (maxError > STRASSEN_CHECK_TOLERANCE)
+        {
+            std::cerr << "Error: Strassen product " << shape[0] << "x" << shape[1] << "x" << shape[2]
+                      << " differs from the blocked product by " << maxError << std::endl;
+            matches = false;
+            break;
+        }
+    }
+    setGemmPolicy(policy);
+    return matches;
+}
+
+/**
+ * prints the results as a table
+ * @param results benchmarks' results
+ */
+static void printTable(const std::vector<BenchResult> &results)
+{
+    std::cout << std::left << std::setw(32) << "benchmark" << std::right << std::setw(14) << "ns/op" << std::setw(14)
+              << "p50 ns" << std::setw(14) << "p99 ns" << std::setw(10) << "GFLOP/s" << std::endl;
+    for (const BenchResult &result : results)
+    {
+        std::cout << std::left << std::setw(32) << result.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << result.nsPerOp << std::setw(14) << result.p50Ns << std::setw(14)
+                  << result.p99Ns << std::setprecision(2) << std::setw(10) << result.gflops << std::endl;
+    }
+}
+
+/**
+ * writes the results as JSON. exits with an error message on failure.
+ * @param filePath path of the file to write
+ * @param results benchmarks' results
+ */
+static void writeJson(const std::string &filePath, const std::vector<BenchResult> &results)
+{
+    std::ofstream ofStream(filePath, std::ios::out | std::ios::trunc);
+    ofStream << "{\n  \"isa\": \"" << simdIsaName(simdKernels().isa) << "\",\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &result = results[i];
+        ofStream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"operations\": "
+                 << result.operations << ", \"ns_per_op\": " << result.nsPerOp << ", \"p50_ns\": " << result.p50Ns
+                 << ", \"p99_ns\": " << result.p99Ns << ", \"gflops\": " << result.gflops << "}";
+    }
+    ofStream << "\n  ]\n}" << std::endl;
+    if (!ofStream)
+    {
+        std::cerr << "Error: could not write file " << filePath << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    std::string jsonPath, profilePath, filter;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            profilePath = argv[++i];
+        }
+        else if (argv[i][0] != '-' && filter.empty())
+        {
+            filter = argv[i];
+        }
+        else
+        {
+            std::cerr << USAGE_MSG << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::vector<BenchResult> results;
+    const auto bench = [&](const std::string &name, const double flops, const auto &operation)
+    {
+        if (name.find(filter) != std::string::npos)
+        {
+            results.push_back(runBenchmark(name, flops, operation));
+        }
+    };
+    std::mt19937 generator(RANDOM_SEED);
+    if (!checkStrassen(generator))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // matrix products: square shapes, the first layer's single vector and batched products, and a skinny one
+    const int productShapes[][3] = {{64, 64, 64}, {256, 256, 256}, {512, 512, 512}, {128, 784, 1},
+                                    {128, 784, BATCH_SIZE}, {10, 20, BATCH_SIZE}};
+    for (const auto &shape : productShapes)
+    {
+        const Matrix a = randomMatrix(shape[0], shape[1], generator), b = randomMatrix(shape[1], shape[2], generator);
+        Matrix c(shape[0], shape[2]);
+        bench("matmul_" + std::to_string(shape[0]) + "x" + std::to_string(shape[1]) + "x" + std::to_string(shape[2]),
+              2.0 * shape[0] * shape[1] * shape[2], [&]
+              {
+                  c = a * b;
+                  sink = c[0];
+              });
+    }
+
+    // a product chain ending in a vector: left to right as written, and re-associated by LazyMatrix
+    {
+        const int size = 256;
+        const Matrix a = randomMatrix(size, size, generator), b = randomMatrix(size, size, generator),
+                c = randomMatrix(size, size, generator), v = randomMatrix(size, 1, generator);
+        Matrix out(size, 1);
+        bench("chain_" + std::to_string(size) + "_eager", 2.0 * size * size * (2.0 * size + 1), [&]
+        {
+            out = a * b * c * v;
+            sink = out[0];
+        });
+        bench("chain_" + std::to_string(size) + "_lazy", 2.0 * 3 * size * size, [&]
+        {
+            out = (LazyMatrix(a) * b * c * v).materialize();
+            sink = out[0];
+        });
+    }
+
+    // element-wise operations, on a vector that fits in L1 cache and on one that doesn't fit in L2 cache
+    const SimdKernelTable &kernels = simdKernels();
+    for (const int size : {4096, 1 << 20})
+    {
+        const Matrix a = randomMatrix(size, 1, generator), b = randomMatrix(size, 1, generator);
+        Matrix c(size, 1);
+        const std::string suffix = "_" + std::to_string(size);
+        bench("add" + suffix, size, [&]
+        {
+            c = a + b;
+            sink = c[0];
+        });
+        bench("scale" + suffix, size, [&]
+        {
+            c = a * 2.0f;
+            sink = c[0];
+        });
+        bench("dot" + suffix, 2.0 * size, [&] { sink = kernels.dot(a.getData(), b.getData(), size); });
+        bench("relu" + suffix, size, [&]
+        {
+            c = Activation(Relu)(a);
+            sink = c[0];
+        });
+        bench("softmax" + suffix, 0, [&]
+        {
+            c = Activation(Softmax)(a);
+            sink = c[0];
+        });
+    }
+
+    // every layer of the default topology as the network runs it, on a single vector and on a batch (the last layer
+    // outputs logits when it's softmax is fused into the argmax)
+    Matrix weights[MLP_SIZE], biases[MLP_SIZE];
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        weights[i] = randomMatrix(weightsDims[i].rows, weightsDims[i].cols, generator);
+        biases[i] = randomMatrix(biasDims[i].rows, biasDims[i].cols, generator);
+    }
+    const MlpNetwork network(weights, biases);
+    for (int i = 0; i < network.getNumLayers(); i++)
+    {
+        const Dense &layer = network.getLayer(i);
+        const int rows = layer.getWeights().getRows(), cols = layer.getWeights().getCols();
+        const Matrix x = randomMatrix(cols, 1, generator), batch = randomMatrix(cols, BATCH_SIZE, generator);
+        std::vector<float> out(rows);
+        const bool logits = i == network.getNumLayers() - 1 && network.getPlan().isArgmaxFused();
+        const std::string name = "dense" + std::to_string(i) + "_" + std::to_string(rows) + "x" + std::to_string(cols) +
+                                 (logits ? "_logits" : "");
+        bench(name + "_single", 2.0 * rows * cols, [&]
+        {
+            layer.apply(x.getData(), out.data());
+            sink = out[0];
+        });
+        bench(name + "_batch" + std::to_string(BATCH_SIZE), 2.0 * rows * cols * BATCH_SIZE, [&]
+        {
+            sink = layer(batch)[0];
+        });
+    }
+
+    // full inference
+    double networkFlops = 0;
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        networkFlops += 2.0 * weightsDims[i].rows * weightsDims[i].cols;
+    }
+    const Matrix img = randomMatrix(imgDims.rows, imgDims.cols, generator);
+    MlpWorkspace workspace(network.getPlan());
+    bench("mlp_single", networkFlops, [&] { sink = network(img, workspace).probability; });
+    const CachedClassifier cachedNetwork(network, LARGE_BATCH_SIZE);
+    bench("mlp_single_cache_hit", 0, [&] { sink = cachedNetwork(img).probability; });
+    for (const int batchSize : {BATCH_SIZE, LARGE_BATCH_SIZE})
+    {
+        const Matrix images = randomMatrix(imgDims.rows * imgDims.cols, batchSize, generator);
+        bench("mlp_batch" + std::to_string(batchSize), networkFlops * batchSize, [&]
+        {
+            sink = network.classifyBatch(images)[0].probability;
+        });
+    }
+
+    std::cout << "isa: " << simdIsaName(kernels.isa) << std::endl;
+    printTable(results);
+    if (!jsonPath.empty())
+    {
+        writeJson(jsonPath, results);
+    }
+    if (!profilePath.empty())
+    {
+        Profiler::printSummary(std::cout);
+        Profiler::writeJson(profilePath);
+    }
+    return 0;
+}
@@ -12,37 +12,257 @@
 
 // ------------------------------ includes ------------------------------
 
+#include <cmath>
+#include <utility>
 #include "MlpNetwork.h"
 
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns a Digit object describing the most probable digit of a given probabilities vector
+ * @param probs vector of probabilities, the i'th probability is at probs[i * stride]
+ * @param size number of probabilities (digits)
+ * @param stride distance between two consecutive probabilities
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableDigit(const float *probs, const int size, const int stride)
+{
+    unsigned int digit = 0;
+    float prob = 0;
+    for (int i = 0; i < size; i++)
+    {
+        if (probs[i * stride] > prob)
+        {
+            digit = i;
+            prob = probs[i * stride];
+        }
+    }
+    Digit digitObjToReturn = {digit, prob};
+    return digitObjToReturn;
+}
+
+/**
+ * returns a Digit object describing the most probable digit of a given logits vector (the input of a Softmax):
+ * softmax followed by argmax in one pass.
+ * @param logits vector of logits, the i'th logit is at logits[i * stride]
+ * @param size number of logits (digits)
+ * @param stride distance between two consecutive logits
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableLogit(const float *logits, const int size, const int stride)
+{
+    unsigned int digit = 0;
+    float maxLogit = logits[0];
+    for (int i = 1; i < size; i++)
+    {
+        if (logits[i * stride] > maxLogit)
+        {
+            digit = i;
+            maxLogit = logits[i * stride];
+        }
+    }
+    float eSum = 0;
+    for (int i = 0; i < size; i++)
+    {
+        eSum += std::exp(logits[i * stride] - maxLogit);
+    }
+    Digit digitObjToReturn = {digit, 1 / eSum};
+    return digitObjToReturn;
+}
+
+/**
+ * exits with an error message if the given layer's weights or bias don't match the network's topology
+ * @param layer layer's index
+ * @param weights layer's weights matrix
+ * @param bias layer's bias vector
+ */
+void checkLayerDims(const int layer, const Matrix &weights, const Matrix &bias)
+{
+    if (weights.getRows() != weightsDims[layer].rows || weights.getCols() != weightsDims[layer].cols)
+    {
+        std::cerr << "Error: weights matrix has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    if (bias.getRows() != biasDims[layer].rows || bias.getCols() != biasDims[layer].cols)
+    {
+        std::cerr << "Error: biases vector has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+}
+
+/**
+ * returns the layers of the default topology (see weightsDims, Relu activations and a Softmax output) made of given
+ * weights and biases. exits with an error message if their dimensions don't match the topology.
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ * @return the network's layers, in order
+ */
+std::vector<LayerSpec> defaultLayerSpecs(Matrix weights[], Matrix biases[])
+{
+    std::vector<LayerSpec> specs;
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        checkLayerDims(i, weights[i], biases[i]);
+        specs.push_back({weights[i], biases[i], defaultActivation(i, MLP_SIZE)});
+    }
+    return specs;
+}
+
+/**
+ * returns the most probable digit of the last layer's output of a network run according to a given plan
+ * (probabilities, or logits if the plan fused the softmax into the argmax)
+ * @param plan network's plan
+ * @param output last layer's output, the i'th value is at output[i * stride]
+ * @param stride distance between two consecutive values
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableOutput(const NetworkPlan &plan, const float *output, const int stride)
+{
+    if (plan.isArgmaxFused())
+    {
+        return mostProbableLogit(output, plan.getOutputSize(), stride);
+    }
+    return mostProbableDigit(output, plan.getOutputSize(), stride);
+}
+
 // ------------------------------ constructors -----------------------------
 
 /**
- * constructor for MlpNetwork object : constructs an MlpNetwork object from a given weight representing matrices
- * and bias representing matrices (actually vectors).
- * @param weights array of matrices representing weights
- * @param biases array of matrices representing biases
+ * constructor for MlpWorkspace object: allocates one output buffer per layer of the default topology (see
+ * getBuffer(), buffer i holds layer i's output)
  */
-MlpNetwork::MlpNetwork(Matrix weights[], Matrix biases[]) :
-        dense0(weights[0], biases[0], Relu), dense1(weights[1], biases[1], Relu),
-        dense2(weights[2], biases[2], Relu), dense3(weights[3], biases[3], Softmax)
+MlpWorkspace::MlpWorkspace() : buffers(MLP_SIZE)
 {
     for (int i = 0; i < MLP_SIZE; i++)
     {
-        if (weights[i].getRows() != weightsDims[i].rows || weights[i].getCols() != weightsDims[i].cols)
+        buffers[i] = Matrix(biasDims[i].rows, biasDims[i].cols, NoInit);
+    }
+}
+
+/**
+ * constructor for MlpWorkspace object: allocates the ping-pong buffers of a given plan (see getBuffer())
+ * @param plan plan of the network the workspace is used with
+ */
+MlpWorkspace::MlpWorkspace(const NetworkPlan &plan)
+{
+    for (int i = 0; i < PLAN_BUFFERS; i++)
+    {
+        buffers.emplace_back(plan.getBufferSize(), 1, NoInit);
+    }
+}
+
+/**
+ * constructor for MlpNetwork object : constructs an MlpNetwork object of the default topology (see weightsDims, Relu
+ * activations and a Softmax output) from a given weight representing matrices and bias representing matrices
+ * (actually vectors).
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ */
+MlpNetwork::MlpNetwork(Matrix weights[], Matrix biases[])
+{
+    build(defaultLayerSpecs(weights, biases));
+}
+
+/**
+ * constructor for MlpNetwork object from a model bundle of any number of layers: the layers view the bundle's
+ * weights and biases directly (no values are copied, unless layers are folded), so the bundle must outlive the
+ * network. the first batch a layer runs packs a copy of it's weights (see Dense), single images copy nothing.
+ * @param bundle model bundle
+ */
+MlpNetwork::MlpNetwork(const ModelBundle &bundle)
+{
+    std::vector<LayerSpec> specs;
+    for (int i = 0; i < bundle.getNumLayers(); i++)
+    {
+        specs.push_back({bundle.getWeights(i), bundle.getBias(i), bundle.getActivation(i)});
+    }
+    build(std::move(specs));
+}
+
+/**
+ * constructor for MlpNetwork object from any sequence of layers. exits with an error message if the layers'
+ * dimensions don't match.
+ * @param specs network's layers, in order
+ */
+MlpNetwork::MlpNetwork(std::vector<LayerSpec> specs)
+{
+    build(std::move(specs));
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * plans the given layers and builds the Dense layers to run
+ * @param specs network's layers, in order
+ */
+void MlpNetwork::build(std::vector<LayerSpec> specs)
+{
+    plan = NetworkPlan::build(specs);
+    layers.reserve(specs.size());
+    for (LayerSpec &spec : specs)
+    {
+        if (spec.weights.isView())
         {
-            std::cerr << "Error: weights matrix has invalid rows or cols number" << std::endl;
-            exit(1);
+            layers.emplace_back(std::move(spec.weights), std::move(spec.bias), spec.activation);
         }
-        if (biases[i].getRows() != biasDims[i].rows || biases[i].getCols() != biasDims[i].cols)
+        else
         {
-            std::cerr << "Error: biases vector has invalid rows or cols number" << std::endl;
-            exit(1);
+            layers.emplace_back(spec.weights, spec.bias, spec.activation);
         }
     }
 }
 
 // ------------------------------ public functions - part of the API -----------------------------
 
+/**
+ * getter for a buffer of at least a given size. the buffer is only (re)allocated when it is smaller.
+ * missing buffers are added, so a workspace built for any plan can be used with any network.
+ * @param index buffer's index
+ * @param size number of values needed
+ * @return the buffer's values
+ */
+float *MlpWorkspace::getBuffer(const int index, const int size)
+{
+    while (index >= (int) buffers.size())
+    {
+        buffers.emplace_back(size, 1, NoInit);
+    }
+    if (buffers[index].getRows() * buffers[index].getCols() < size)
+    {
+        buffers[index] = Matrix(size, 1, NoInit);
+    }
+    return buffers[index].getData();
+}
+
+/**
+ * getter for the network's plan
+ * @return network's plan
+ */
+const NetworkPlan &MlpNetwork::getPlan() const
+{
+    return this->plan;
+}
+
+/**
+ * getter for the number of layers the network runs (after folding)
+ * @return number of layers
+ */
+int MlpNetwork::getNumLayers() const
+{
+    return (int) this->layers.size();
+}
+
+/**
+ * getter for one of the network's layers (after folding). when the plan fused the last layer's Softmax into the
+ * argmax (see NetworkPlan::isArgmaxFused()), the last layer has no activation and outputs logits.
+ * @param layer layer's index
+ * @return the layer
+ */
+const Dense &MlpNetwork::getLayer(const int layer) const
+{
+    return this->layers[layer];
+}
+
 /**
  * overloading operator "()" for MlpNetwork object: returns a Digit object presents what digit is described on given
  * matrix presenting an image and at what probability.
@@ -51,20 +271,61 @@ MlpNetwork::MlpNetwork(Matrix weights[], Matrix biases[]) :
  */
 Digit MlpNetwork::operator()(const Matrix &img) const
 {
-    Matrix r1 = dense0(img);
-    r1 = dense1(r1);
-    r1 = dense2(r1);
-    r1 = dense3(r1);
-    unsigned int digit = 0;
-    float prob = 0;
-    for (int i = 0; i < 10; i++)
+    static thread_local MlpWorkspace workspace;
+    return (*this)(img, workspace);
+}
+
+/**
+ * overloading operator "()" for MlpNetwork object with a caller provided workspace: same as operator()(img), but
+ * every layer writes it's output into the workspace's ping-pong buffers through the fused Dense kernel, so no heap
+ * allocation is made.
+ * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit MlpNetwork::operator()(const Matrix &img, MlpWorkspace &workspace) const
+{
+    return classifyWithPlan(plan, layers, img, workspace);
+}
+
+/**
+ * classifies a batch of images in one forward pass: every layer runs as one matrix product over the whole batch,
+ * so each weight matrix is streamed from memory once per batch instead of once per image.
+ * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> MlpNetwork::classifyBatch(const Matrix &images) const
+{
+    return classifyBatchWithPlan(plan, layers, images);
+}
+
+/**
+ * classifies a batch of images in one forward pass (see classifyBatch(const Matrix &)).
+ * @param images vector of images, each image is a matrix of any shape with as many values as the first layer's
+ * inputs
+ * @return vector of Digit objects, the i'th Digit describes the i'th image
+ */
+std::vector<Digit> MlpNetwork::classifyBatch(const std::vector<Matrix> &images) const
+{
+    const int imgSize = plan.getInputSize();
+    const int batchSize = (int) images.size();
+    if (batchSize == 0)
     {
-        if (r1[i] > prob)
+        return std::vector<Digit>();
+    }
+    Matrix batch(imgSize, batchSize, NoInit);
+    float *batchValues = batch.getData();
+    for (int j = 0; j < batchSize; j++)
+    {
+        if (images[j].getRows() * images[j].getCols() != imgSize)
         {
-            digit = i;
-            prob = r1[i];
+            std::cerr << "Error: image in batch has invalid rows or cols number" << std::endl;
+            exit(1);
+        }
+        for (int i = 0; i < imgSize; i++)
+        {
+            batchValues[(long) i * batchSize + j] = images[j].elementAt(i);
         }
     }
-    Digit digitObjToReturn = {digit, prob};
-    return digitObjToReturn;
+    return classifyBatch(batch);
 }
\ No newline at end of file
@@ -10,41 +10,240 @@
 #ifndef MLPNETWORK_H
 #define MLPNETWORK_H
 
+#include <vector>
 #include "Matrix.h"
 #include "Digit.h"
 #include "Dense.h"
+#include "DigitClassifier.h"
+#include "ModelBundle.h"
+#include "NetworkPlan.h"
+#include "Profiler.h"
 
 #define MLP_SIZE 4
 
-const MatrixDims imgDims = {28, 28};
-const MatrixDims weightsDims[] = {{128, 784},
-                                  {64,  128},
-                                  {20,  64},
-                                  {10,  20}};
-const MatrixDims biasDims[] = {{128, 1},
-                               {64,  1},
-                               {20,  1},
-                               {10,  1}};
+constexpr MatrixDims imgDims = {28, 28};
+constexpr MatrixDims weightsDims[] = {{128, 784},
+                                      {64,  128},
+                                      {20,  64},
+                                      {10,  20}};
+constexpr MatrixDims biasDims[] = {{128, 1},
+                                   {64,  1},
+                                   {20,  1},
+                                   {10,  1}};
 
 /**
- * class of MlpNetwork object
+ * class of MlpWorkspace object: preallocated buffers for every intermediate result of one network inference.
+ * classifying with a workspace does no heap allocation at all (once it's buffers are large enough). a workspace may
+ * be reused for any number of inferences, but only by one thread at a time.
  */
-class MlpNetwork
+class MlpWorkspace
 {
 private:
-    Dense dense0;
-    Dense dense1;
-    Dense dense2;
-    Dense dense3;
+    std::vector<Matrix> buffers;
 public:
     /**
-     * constructor for MlpNetwork object : constructs an MlpNetwork object from a given weight representing matrices
-     * and bias representing matrices (actually vectors).
-     * @param weights array of matrices representing weights
-     * @param biases array of matrices representing biases
+     * constructor for MlpWorkspace object: allocates one output buffer per layer of the default topology (see
+     * getBuffer(), buffer i holds layer i's output)
+     */
+    MlpWorkspace();
+
+    /**
+     * constructor for MlpWorkspace object: allocates the ping-pong buffers of a given plan (see getBuffer())
+     * @param plan plan of the network the workspace is used with
+     */
+    explicit MlpWorkspace(const NetworkPlan &plan);
+
+    /**
+     * getter for a buffer of at least a given size. the buffer is only (re)allocated when it is smaller.
+     * missing buffers are added, so a workspace built for any plan can be used with any network.
+     * @param index buffer's index
+     * @param size number of values needed
+     * @return the buffer's values
+     */
+    float *getBuffer(int index, int size);
+};
+
+/**
+ * returns a Digit object describing the most probable digit of a given probabilities vector
+ * @param probs vector of probabilities, the i'th probability is at probs[i * stride]
+ * @param size number of probabilities (digits)
+ * @param stride distance between two consecutive probabilities
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableDigit(const float *probs, int size, int stride);
+
+/**
+ * returns a Digit object describing the most probable digit of a given logits vector (the input of a Softmax):
+ * softmax followed by argmax in one pass. the most probable digit is the largest logit, and it's probability is
+ * 1 / sum(exp(logits[i] - max)), so only one vector of exponents is summed and no probabilities vector is written.
+ * @param logits vector of logits, the i'th logit is at logits[i * stride]
+ * @param size number of logits (digits)
+ * @param stride distance between two consecutive logits
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableLogit(const float *logits, int size, int stride);
+
+/**
+ * exits with an error message if the given layer's weights or bias don't match the network's topology
+ * @param layer layer's index
+ * @param weights layer's weights matrix
+ * @param bias layer's bias vector
+ */
+void checkLayerDims(int layer, const Matrix &weights, const Matrix &bias);
+
+/**
+ * returns the layers of the default topology (see weightsDims, Relu activations and a Softmax output) made of given
+ * weights and biases. exits with an error message if their dimensions don't match the topology.
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ * @return the network's layers, in order
+ */
+std::vector<LayerSpec> defaultLayerSpecs(Matrix weights[], Matrix biases[]);
+
+/**
+ * returns the most probable digit of the last layer's output of a network run according to a given plan
+ * (probabilities, or logits if the plan fused the softmax into the argmax)
+ * @param plan network's plan
+ * @param output last layer's output, the i'th value is at output[i * stride]
+ * @param stride distance between two consecutive values
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit mostProbableOutput(const NetworkPlan &plan, const float *output, int stride);
+
+/**
+ * classifies an image by running a network's layers according to it's plan: every layer writes it's output into
+ * one of the workspace's ping-pong buffers through it's fused single vector kernel (apply()), so no heap allocation
+ * is made. exits with an error message if the image doesn't have as many values as the first layer's inputs.
+ * @tparam Layer type of the layers (Dense or one of it's reduced precision or sparse variants)
+ * @param plan network's plan
+ * @param layers network's layers, the plan's i'th step runs the i'th layer
+ * @param img given matrix presents an image describing a digit
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on the image and at what probability.
+ */
+template<class Layer>
+Digit classifyWithPlan(const NetworkPlan &plan, const std::vector<Layer> &layers, const Matrix &img,
+                       MlpWorkspace &workspace)
+{
+    if (img.getRows() * img.getCols() != plan.getInputSize())
+    {
+        std::cerr << "Error: image has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    if (img.getLeadingDim() != img.getCols())
+    {
+        return classifyWithPlan(plan, layers, Matrix(img, PackedRows), workspace);
+    }
+    float *buffers[PLAN_BUFFERS];
+    for (int i = 0; i < PLAN_BUFFERS; i++)
+    {
+        buffers[i] = workspace.getBuffer(i, plan.getBufferSize());
+    }
+    const std::vector<PlanStep> &steps = plan.getSteps();
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        PROFILE_LAYER((int) i);
+        const float *input = steps[i].inputBuffer == NETWORK_INPUT ? img.getData() : buffers[steps[i].inputBuffer];
+        layers[i].apply(input, buffers[steps[i].outputBuffer]);
+    }
+    return mostProbableOutput(plan, buffers[steps.back().outputBuffer], 1);
+}
+
+/**
+ * classifies a batch of images by running a network's layers according to it's plan, every layer on the whole
+ * batch at once. exits with an error message if the batch doesn't have a row per input of the first layer.
+ * @tparam Layer type of the layers (Dense or one of it's reduced precision or sparse variants)
+ * @param plan network's plan
+ * @param layers network's layers, the plan's i'th step runs the i'th layer
+ * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+template<class Layer>
+std::vector<Digit> classifyBatchWithPlan(const NetworkPlan &plan, const std::vector<Layer> &layers,
+                                         const Matrix &images)
+{
+    if (images.getRows() != plan.getInputSize())
+    {
+        std::cerr << "Error: batch of images has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    Matrix r1;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        PROFILE_LAYER((int) i);
+        r1 = layers[i](i == 0 ? images : r1);
+    }
+    const int batchSize = r1.getCols();
+    std::vector<Digit> digitsToReturn;
+    digitsToReturn.reserve(batchSize);
+    for (int j = 0; j < batchSize; j++)
+    {
+        digitsToReturn.push_back(mostProbableOutput(plan, r1.getData() + j, batchSize));
+    }
+    return digitsToReturn;
+}
+
+/**
+ * class of MlpNetwork object: any sequence of Dense layers, run according to a NetworkPlan built when the network
+ * is constructed (see NetworkPlan.h).
+ */
+class MlpNetwork : public DigitClassifier
+{
+private:
+    std::vector<Dense> layers;
+    NetworkPlan plan;
+
+    /**
+     * plans the given layers and builds the Dense layers to run
+     * @param specs network's layers, in order
+     */
+    void build(std::vector<LayerSpec> specs);
+
+public:
+    /**
+     * constructor for MlpNetwork object : constructs an MlpNetwork object of the default topology (see weightsDims,
+     * Relu activations and a Softmax output) from a given weight representing matrices and bias representing
+     * matrices (actually vectors).
+     * @param weights array of MLP_SIZE matrices representing weights
+     * @param biases array of MLP_SIZE matrices representing biases
      */
     MlpNetwork(Matrix weights[], Matrix biases[]);
 
+    /**
+     * constructor for MlpNetwork object from a model bundle of any number of layers: the layers view the bundle's
+     * weights and biases directly (no values are copied, unless layers are folded), so the bundle must outlive the
+     * network. the first batch a layer runs packs a copy of it's weights (see Dense), single images copy nothing.
+     * @param bundle model bundle
+     */
+    explicit MlpNetwork(const ModelBundle &bundle);
+
+    /**
+     * constructor for MlpNetwork object from any sequence of layers. exits with an error message if the layers'
+     * dimensions don't match.
+     * @param specs network's layers, in order
+     */
+    explicit MlpNetwork(std::vector<LayerSpec> specs);
+
+    /**
+     * getter for the network's plan
+     * @return network's plan
+     */
+    const NetworkPlan &getPlan() const;
+
+    /**
+     * getter for the number of layers the network runs (after folding)
+     * @return number of layers
+     */
+    int getNumLayers() const;
+
+    /**
+     * getter for one of the network's layers (after folding). when the plan fused the last layer's Softmax into the
+     * argmax (see NetworkPlan::isArgmaxFused()), the last layer has no activation and outputs logits.
+     * @param layer layer's index
+     * @return the layer
+     */
+    const Dense &getLayer(int layer) const;
+
     /**
      * overloading operator "()" for MlpNetwork object: returns a Digit object presents what digit is described on
      * given matrix presenting an image and at what probability.
@@ -52,7 +251,34 @@ public:
      * @return Digit object presents what digit is described on given matrix presenting an image and at what
      * probability.
      */
-    Digit operator()(const Matrix &img) const;
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * overloading operator "()" for MlpNetwork object with a caller provided workspace: same as operator()(img), but
+     * every layer writes it's output into the workspace's ping-pong buffers through the fused Dense kernel, so no
+     * heap allocation is made.
+     * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+     * @param workspace workspace to hold the intermediate results
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img, MlpWorkspace &workspace) const;
+
+    /**
+     * classifies a batch of images in one forward pass: every layer runs as one matrix product over the whole batch,
+     * so each weight matrix is streamed from memory once per batch instead of once per image.
+     * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    std::vector<Digit> classifyBatch(const Matrix &images) const override;
+
+    /**
+     * classifies a batch of images in one forward pass (see classifyBatch(const Matrix &)).
+     * @param images vector of images, each image is a matrix of any shape with as many values as the first layer's
+     * inputs
+     * @return vector of Digit objects, the i'th Digit describes the i'th image
+     */
+    std::vector<Digit> classifyBatch(const std::vector<Matrix> &images) const;
 };
 
 #endif // MLPNETWORK_H
@@ -0,0 +1,108 @@
+/**
+ * @file MlpServer.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief program that keeps an MlpNetwork resident and classifies the images sent to it over stdin or a Unix domain
+ * socket, grouping concurrent requests into batches (see BatchingServer.h for the protocol).
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include "MlpNetwork.h"
+#include "ModelBundle.h"
+#include "BatchingServer.h"
+#include "CachedClassifier.h"
+
+// -------------------------- const definitions -------------------------
+
+#define USAGE_MSG "Usage: mlpserver [-b max_batch_size] [-d deadline_us] [-c cache_entries] [-s socket_path] " \
+                  "model_bundle\n" \
+                  "       serves requests from stdin (responses to stdout), or from every connection to the Unix\n" \
+                  "       domain socket at socket_path. with -c, repeated images are answered from a result cache"
+#define DEFAULT_MAX_BATCH_SIZE 64
+#define DEFAULT_MAX_DELAY_MICROS 1000
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    BatchingConfig config = {DEFAULT_MAX_BATCH_SIZE, DEFAULT_MAX_DELAY_MICROS};
+    long cacheEntries = 0;
+    std::string socketPath, bundlePath;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+            config.maxBatchSize = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            config.maxDelayMicros = std::atol(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            cacheEntries = std::atol(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            socketPath = argv[++i];
+        }
+        else if (argv[i][0] != '-' && bundlePath.empty())
+        {
+            bundlePath = argv[i];
+        }
+        else
+        {
+            std::cerr << USAGE_MSG << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (bundlePath.empty())
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // a client that disconnects before reading it's responses must only end it's own stream
+    std::signal(SIGPIPE, SIG_IGN);
+    const ModelBundle bundle(bundlePath);
+    const MlpNetwork network(bundle);
+    std::unique_ptr<CachedClassifier> cached;
+    if (cacheEntries > 0)
+    {
+        cached.reset(new CachedClassifier(network, cacheEntries));
+    }
+    const DigitClassifier &classifier = cached ? (const DigitClassifier &) *cached : network;
+    BatchingServer server(classifier, network.getPlan().getInputSize(), config);
+    std::cerr << "plan: " << network.getPlan().describe() << std::endl;
+    std::cerr << "batches of up to " << config.maxBatchSize << " requests, deadline " << config.maxDelayMicros
+              << " us" << std::endl;
+    if (!socketPath.empty())
+    {
+        std::cerr << "listening on " << socketPath << std::endl;
+        server.serveSocket(socketPath);
+    }
+    const long served = server.serveStream(STDIN_FILENO, STDOUT_FILENO);
+    std::cerr << "served " << served << " requests in " << server.getServedBatches() << " batches" << std::endl;
+    if (cached)
+    {
+        const CacheStats stats = cached->getStats();
+        std::cerr << "cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions
+                  << " evictions, " << stats.entries << " entries" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file MlpTrain.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief program to train the MlpNetwork on a labeled set of images in the IDX format (the format of the MNIST
+ * files) and write the trained weights both as a model bundle and as the raw weight and bias files.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "MlpNetwork.h"
+#include "ModelBundle.h"
+#include "Trainer.h"
+
+// -------------------------- const definitions -------------------------
+
+#define FIRST_OPTIONAL_ARG 4
+#define USAGE_MSG "Usage: mlptrain images_idx labels_idx output_prefix [sgd|adam [epochs [batch_size " \
+                  "[learning_rate [threads]]]]]\n" \
+                  "       writes output_prefix.bundle and the raw files output_prefix_w1 ... output_prefix_b4"
+#define IDX_IMAGES_MAGIC 0x00000803
+#define IDX_LABELS_MAGIC 0x00000801
+#define MAX_PIXEL 255.0f
+#define DEFAULT_EPOCHS 10
+#define DEFAULT_BATCH_SIZE 128
+#define DEFAULT_SGD_LEARNING_RATE 0.1f
+#define DEFAULT_SGD_MOMENTUM 0.9f
+#define DEFAULT_ADAM_LEARNING_RATE 0.001f
+#define RANDOM_SEED 2019
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * reads a big-endian 32 bit integer of an IDX file's header
+ * @param ifStream stream to read from
+ * @return the integer
+ */
+static uint32_t readBigEndian(std::ifstream &ifStream)
+{
+    unsigned char bytes[4] = {0, 0, 0, 0};
+    ifStream.read((char *) bytes, sizeof(bytes));
+    return (uint32_t) bytes[0] << 24 | (uint32_t) bytes[1] << 16 | (uint32_t) bytes[2] << 8 | bytes[3];
+}
+
+/**
+ * opens an IDX file and checks it's magic number. exits with an error message on failure.
+ * @param filePath path of the file
+ * @param magic expected magic number
+ * @param ifStream stream to open
+ */
+static void openIdxFile(const std::string &filePath, const uint32_t magic, std::ifstream &ifStream)
+{
+    ifStream.open(filePath, std::ios::in | std::ios::binary);
+    if (!ifStream.is_open() || readBigEndian(ifStream) != magic)
+    {
+        std::cerr << "Error: " << filePath << " is not an IDX file of the expected type" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * reads an IDX file of images, one image per row, with the pixels scaled to [0, 1]. exits with an error message on
+ * failure or if the images aren't of the network's input size.
+ * @param filePath path of the file
+ * @return matrix of one image per row
+ */
+static Matrix readIdxImages(const std::string &filePath)
+{
+    std::ifstream ifStream;
+    openIdxFile(filePath, IDX_IMAGES_MAGIC, ifStream);
+    const int count = (int) readBigEndian(ifStream);
+    const int rows = (int) readBigEndian(ifStream), cols = (int) readBigEndian(ifStream);
+    if (rows != imgDims.rows || cols != imgDims.cols)
+    {
+        std::cerr << "Error: " << filePath << " has images of invalid size" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::vector<unsigned char> pixels((size_t) count * rows * cols);
+    ifStream.read((char *) pixels.data(), (long) pixels.size());
+    if (!ifStream)
+    {
+        std::cerr << "Error: " << filePath << " is truncated" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    Matrix images(count, rows * cols, NoInit);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        images.getData()[i] = (float) pixels[i] / MAX_PIXEL;
+    }
+    return images;
+}
+
+/**
+ * reads an IDX file of labels. exits with an error message on failure or if a label isn't a digit.
+ * @param filePath path of the file
+ * @return the labels
+ */
+static std::vector<int> readIdxLabels(const std::string &filePath)
+{
+    std::ifstream ifStream;
+    openIdxFile(filePath, IDX_LABELS_MAGIC, ifStream);
+    std::vector<unsigned char> bytes(readBigEndian(ifStream));
+    ifStream.read((char *) bytes.data(), (long) bytes.size());
+    if (!ifStream)
+    {
+        std::cerr << "Error: " << filePath << " is truncated" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::vector<int> labels(bytes.begin(), bytes.end());
+    if (std::any_of(labels.begin(), labels.end(), [](int label) { return label >= biasDims[MLP_SIZE - 1].rows; }))
+    {
+        std::cerr << "Error: " << filePath << " has an invalid label" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return labels;
+}
+
+/**
+ * returns the default topology's layers with He initialized weights (uniform in +-sqrt(6 / inputs)) and zero biases
+ * @param generator random generator
+ * @return the initial layers
+ */
+static std::vector<LayerSpec> initialLayers(std::mt19937 &generator)
+{
+    std::vector<LayerSpec> layers;
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        const float limit = std::sqrt(6.0f / (float) weightsDims[i].cols);
+        std::uniform_real_distribution<float> distribution(-limit, limit);
+        Matrix weights(weightsDims[i].rows, weightsDims[i].cols, NoInit);
+        for (int j = 0; j < weights.getRows() * weights.getCols(); j++)
+        {
+            weights[j] = distribution(generator);
+        }
+        layers.push_back({weights, Matrix(biasDims[i].rows, biasDims[i].cols), defaultActivation(i, MLP_SIZE)});
+    }
+    return layers;
+}
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < FIRST_OPTIONAL_ARG || argc > FIRST_OPTIONAL_ARG + 5)
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+    const bool adam = argc > FIRST_OPTIONAL_ARG && std::strcmp(argv[FIRST_OPTIONAL_ARG], "adam") == 0;
+    if (argc > FIRST_OPTIONAL_ARG && !adam && std::strcmp(argv[FIRST_OPTIONAL_ARG], "sgd") != 0)
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int epochs = argc > FIRST_OPTIONAL_ARG + 1 ? std::atoi(argv[FIRST_OPTIONAL_ARG + 1]) : DEFAULT_EPOCHS;
+    const int batchSize = argc > FIRST_OPTIONAL_ARG + 2 ? std::atoi(argv[FIRST_OPTIONAL_ARG + 2]) : DEFAULT_BATCH_SIZE;
+    const float learningRate = argc > FIRST_OPTIONAL_ARG + 3 ? std::strtof(argv[FIRST_OPTIONAL_ARG + 3], nullptr) :
+                               adam ? DEFAULT_ADAM_LEARNING_RATE : DEFAULT_SGD_LEARNING_RATE;
+    const int numThreads = argc > FIRST_OPTIONAL_ARG + 4 ? std::atoi(argv[FIRST_OPTIONAL_ARG + 4]) : 0;
+    if (epochs <= 0 || batchSize <= 0 || learningRate <= 0 || numThreads < 0)
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const Matrix images = readIdxImages(argv[1]);
+    const std::vector<int> labels = readIdxLabels(argv[2]);
+    if ((int) labels.size() != images.getRows())
+    {
+        std::cerr << "Error: number of labels doesn't match the number of images" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::mt19937 generator(RANDOM_SEED);
+    SgdOptimizer sgd(learningRate, DEFAULT_SGD_MOMENTUM);
+    AdamOptimizer adamOptimizer(learningRate);
+    Trainer trainer(initialLayers(generator), adam ? (Optimizer &) adamOptimizer : (Optimizer &) sgd, numThreads);
+    std::cout << "training on " << images.getRows() << " images, " << (adam ? "adam" : "sgd") << ", batches of "
+              << batchSize << ", learning rate " << learningRate << ", " << trainer.getNumThreads() << " threads"
+              << std::endl;
+
+    const int inputSize = images.getCols();
+    std::vector<int> order(images.getRows());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = (int) i;
+    }
+    Matrix batch;
+    std::vector<int> batchLabels;
+    for (int epoch = 1; epoch <= epochs; epoch++)
+    {
+        std::shuffle(order.begin(), order.end(), generator);
+        double lossSum = 0;
+        long correct = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < order.size(); first += batchSize)
+        {
+            // the batch's images are gathered into columns, the layout the layers' products take
+            const int size = (int) std::min((size_t) batchSize, order.size() - first);
+            if (batch.getCols() != size)
+            {
+                batch = Matrix(inputSize, size, NoInit);
+            }
+            batchLabels.resize(size);
+            for (int j = 0; j < size; j++)
+            {
+                const float *image = images.getData() + (long) order[first + j] * inputSize;
+                for (int i = 0; i < inputSize; i++)
+                {
+                    batch.getData()[(long) i * size + j] = image[i];
+                }
+                batchLabels[j] = labels[order[first + j]];
+            }
+            const BatchResult result = trainer.trainBatch(batch, batchLabels.data());
+            lossSum += (double) result.loss * size;
+            correct += result.correct;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double samplesPerSecond = (double) order.size() / seconds;
+        std::cout << "epoch " << epoch << ": loss " << lossSum / (double) order.size() << ", accuracy "
+                  << 100.0 * (double) correct / (double) order.size() << "%, " << samplesPerSecond << " samples/s ("
+                  << samplesPerSecond / trainer.getNumThreads() << " per thread)" << std::endl;
+    }
+
+    const std::string prefix = argv[3];
+    trainer.writeBundle(prefix + ".bundle");
+    const std::vector<LayerSpec> layers = trainer.getLayers();
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        writeRawMatrixFile(prefix + "_w" + std::to_string(i + 1), layers[i].weights);
+        writeRawMatrixFile(prefix + "_b" + std::to_string(i + 1), layers[i].bias);
+    }
+    std::cout << "wrote " << prefix << ".bundle and " << prefix << "_w1 ... " << prefix << "_b" << MLP_SIZE
+              << std::endl;
+    return 0;
+}
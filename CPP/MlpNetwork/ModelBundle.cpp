@@ -0,0 +1,369 @@
+/**
+ * @file ModelBundle.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ModelBundle object class - single file, memory mapped model (all weights and biases of a network)
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ModelBundle.h"
+
+// -------------------------- const definitions -------------------------
+
+#define EXIT_CODE 1
+
+/**
+ * @def FNV_OFFSET_BASIS
+ * @brief initial value of the 64 bit FNV-1a checksum
+ */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/**
+ * @def FNV_PRIME
+ * @brief multiplier of the 64 bit FNV-1a checksum
+ */
+#define FNV_PRIME 0x100000001b3ULL
+
+static_assert(sizeof(BundleHeader) == BUNDLE_ALIGNMENT, "bundle header must fill exactly one aligned block");
+static_assert(sizeof(BundleTensor) == 16, "bundle tensor table entries must be 16 bytes");
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * exits with an error message about the given bundle file
+ * @param filePath path of the bundle file
+ * @param problem what is wrong with it
+ */
+static void bundleError(const std::string &filePath, const char *problem)
+{
+    std::cerr << "Error: model bundle " << filePath << ": " << problem << std::endl;
+    exit(EXIT_CODE);
+}
+
+/**
+ * rounds a size up to a multiple of BUNDLE_ALIGNMENT
+ * @param size size in bytes
+ * @return the aligned size
+ */
+static uint64_t alignUp(const uint64_t size)
+{
+    return (size + BUNDLE_ALIGNMENT - 1) / BUNDLE_ALIGNMENT * BUNDLE_ALIGNMENT;
+}
+
+/**
+ * 64 bit FNV-1a over the 64 bit words of a buffer (a word at a time instead of a byte at a time)
+ * @param data buffer to checksum, size must be a multiple of 8
+ * @param size buffer's size in bytes
+ * @return the checksum
+ */
+static uint64_t bundleChecksum(const unsigned char *data, const uint64_t size)
+{
+    uint64_t checksum = FNV_OFFSET_BASIS;
+    for (uint64_t i = 0; i < size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        checksum = (checksum ^ word) * FNV_PRIME;
+    }
+    return checksum;
+}
+
+// ------------------------------ constructors and destructors -----------------------------
+
+/**
+ * constructor for ModelBundle object: maps a bundle file and validates it (magic, version, size, alignment,
+ * bounds and overlap of every tensor, checksum). exits with an error message if the file is not a valid bundle.
+ * @param filePath path of the bundle file
+ * @param verifyChecksum whether to verify the checksum (which reads the whole file)
+ */
+ModelBundle::ModelBundle(const std::string &filePath, const bool verifyChecksum) : mapping(nullptr), mappingSize(0),
+                                                                                   header(nullptr), tensors(nullptr),
+                                                                                   activations(nullptr)
+{
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        bundleError(filePath, "could not open file");
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof(BundleHeader))
+    {
+        close(fd);
+        bundleError(filePath, "file is too small");
+    }
+    mappingSize = (size_t) fileStat.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        bundleError(filePath, "could not map file");
+    }
+    const unsigned char *bytes = (const unsigned char *) mapping;
+    header = (const BundleHeader *) bytes;
+    if (std::memcmp(header->magic, BUNDLE_MAGIC, sizeof(header->magic)) != 0)
+    {
+        bundleError(filePath, "not a model bundle");
+    }
+    if (header->version != 1 && header->version != BUNDLE_VERSION)
+    {
+        bundleError(filePath, "unsupported bundle version");
+    }
+    if (header->fileSize != mappingSize)
+    {
+        bundleError(filePath, "file is truncated");
+    }
+    if (mappingSize % sizeof(uint64_t) != 0)
+    {
+        bundleError(filePath, "file size is not a multiple of 8");
+    }
+    const uint64_t numTensors = 2 * (uint64_t) header->numLayers;
+    const uint64_t activationTableSize = header->version == 1 ? 0 : header->numLayers * sizeof(uint32_t);
+    if (header->numLayers == 0 || header->numLayers > INT32_MAX / 2 ||
+        sizeof(BundleHeader) + numTensors * sizeof(BundleTensor) + activationTableSize > mappingSize)
+    {
+        bundleError(filePath, "invalid tensor table");
+    }
+    tensors = (const BundleTensor *) (bytes + sizeof(BundleHeader));
+    if (activationTableSize != 0)
+    {
+        activations = (const uint32_t *) (tensors + numTensors);
+        for (uint32_t i = 0; i < header->numLayers; i++)
+        {
+            if (activations[i] > LogSoftmax)
+            {
+                bundleError(filePath, "invalid activation");
+            }
+        }
+    }
+    // tensors are checked in the order of their offsets, so each must start after the previous one (or the tables)
+    std::vector<uint64_t> byOffset(numTensors);
+    for (uint64_t i = 0; i < numTensors; i++)
+    {
+        byOffset[i] = i;
+    }
+    std::sort(byOffset.begin(), byOffset.end(), [this](const uint64_t a, const uint64_t b)
+    {
+        return tensors[a].offset < tensors[b].offset;
+    });
+    uint64_t dataBegin = sizeof(BundleHeader) + numTensors * sizeof(BundleTensor) + activationTableSize;
+    for (const uint64_t i : byOffset)
+    {
+        const uint64_t tensorSize = (uint64_t) tensors[i].rows * tensors[i].cols * sizeof(float);
+        if (tensors[i].rows == 0 || tensors[i].cols == 0 || tensors[i].rows > INT32_MAX ||
+            tensors[i].cols > INT32_MAX || tensors[i].offset % BUNDLE_ALIGNMENT != 0 ||
+            tensors[i].offset < dataBegin || tensors[i].offset > mappingSize ||
+            tensorSize > mappingSize - tensors[i].offset)
+        {
+            bundleError(filePath, "invalid tensor");
+        }
+        dataBegin = tensors[i].offset + tensorSize;
+    }
+    if (verifyChecksum &&
+        bundleChecksum(bytes + sizeof(BundleHeader), mappingSize - sizeof(BundleHeader)) != header->checksum)
+    {
+        bundleError(filePath, "checksum mismatch");
+    }
+    madvise(mapping, mappingSize, MADV_WILLNEED);
+}
+
+/**
+ * destructor for ModelBundle object: unmaps the file. every view handed out must be gone by then.
+ */
+ModelBundle::~ModelBundle()
+{
+    munmap(mapping, mappingSize);
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * returns a view of one entry of the tensor table
+ * @param index entry's index
+ * @return matrix viewing the tensor's values
+ */
+Matrix ModelBundle::tensorView(const int index) const
+{
+    if (index < 0 || index >= 2 * (int) header->numLayers)
+    {
+        std::cerr << "Error: model bundle has no layer " << index / 2 << std::endl;
+        exit(EXIT_CODE);
+    }
+    const BundleTensor &tensor = tensors[index];
+    return Matrix::view((float *) ((unsigned char *) mapping + tensor.offset), (int) tensor.rows, (int) tensor.cols);
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the number of layers in the bundle
+ * @return number of layers
+ */
+int ModelBundle::getNumLayers() const
+{
+    return (int) header->numLayers;
+}
+
+/**
+ * returns a view of a layer's weights matrix
+ * @param layer layer's index
+ * @return matrix viewing the weights
+ */
+Matrix ModelBundle::getWeights(const int layer) const
+{
+    return tensorView(2 * layer);
+}
+
+/**
+ * returns a view of a layer's bias vector
+ * @param layer layer's index
+ * @return matrix viewing the bias
+ */
+Matrix ModelBundle::getBias(const int layer) const
+{
+    return tensorView(2 * layer + 1);
+}
+
+/**
+ * getter for a layer's activation
+ * @param layer layer's index
+ * @return the layer's ActivationType
+ */
+ActivationType ModelBundle::getActivation(const int layer) const
+{
+    if (layer < 0 || layer >= (int) header->numLayers)
+    {
+        std::cerr << "Error: model bundle has no layer " << layer << std::endl;
+        exit(EXIT_CODE);
+    }
+    if (activations == nullptr)
+    {
+        return defaultActivation(layer, (int) header->numLayers);
+    }
+    return (ActivationType) activations[layer];
+}
+
+/**
+ * writes a bundle file from given weights, biases and activations. exits with an error message on failure.
+ * @param filePath path of the bundle file to write
+ * @param weights array of numLayers matrices representing weights
+ * @param biases array of numLayers matrices representing biases
+ * @param numLayers number of layers
+ * @param activations array of numLayers activations, or nullptr for the default activations
+ */
+void ModelBundle::write(const std::string &filePath, const Matrix weights[], const Matrix biases[],
+                        const int numLayers, const ActivationType activations[])
+{
+    const int numTensors = 2 * numLayers;
+    const uint64_t activationTable = sizeof(BundleHeader) + numTensors * sizeof(BundleTensor);
+    uint64_t offset = alignUp(activationTable + numLayers * sizeof(uint32_t));
+    std::vector<BundleTensor> table(numTensors);
+    for (int i = 0; i < numTensors; i++)
+    {
+        const Matrix &m = i % 2 == 0 ? weights[i / 2] : biases[i / 2];
+        table[i] = {(uint32_t) m.getRows(), (uint32_t) m.getCols(), offset};
+        offset = alignUp(offset + (uint64_t) m.getRows() * m.getCols() * sizeof(float));
+    }
+    std::vector<unsigned char> file(offset, 0);
+    std::memcpy(file.data() + sizeof(BundleHeader), table.data(), numTensors * sizeof(BundleTensor));
+    for (int i = 0; i < numLayers; i++)
+    {
+        const uint32_t activation = activations == nullptr ? defaultActivation(i, numLayers) : activations[i];
+        std::memcpy(file.data() + activationTable + i * sizeof(uint32_t), &activation, sizeof(activation));
+    }
+    for (int i = 0; i < numTensors; i++)
+    {
+        const Matrix &m = i % 2 == 0 ? weights[i / 2] : biases[i / 2];
+        for (int row = 0; row < m.getRows(); row++)
+        {
+            std::memcpy(file.data() + table[i].offset + (size_t) row * m.getCols() * sizeof(float),
+                        m.getData() + (long) row * m.getLeadingDim(), m.getCols() * sizeof(float));
+        }
+    }
+    BundleHeader bundleHeader = {};
+    std::memcpy(bundleHeader.magic, BUNDLE_MAGIC, sizeof(bundleHeader.magic));
+    bundleHeader.version = BUNDLE_VERSION;
+    bundleHeader.numLayers = (uint32_t) numLayers;
+    bundleHeader.fileSize = offset;
+    bundleHeader.checksum = bundleChecksum(file.data() + sizeof(BundleHeader), offset - sizeof(BundleHeader));
+    std::memcpy(file.data(), &bundleHeader, sizeof(BundleHeader));
+
+    std::ofstream ofStream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    ofStream.write((const char *) file.data(), (std::streamsize) file.size());
+    if (!ofStream.good())
+    {
+        bundleError(filePath, "could not write file");
+    }
+}
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns the activation of a layer of a network that doesn't specify it's activations (the original MlpNetwork
+ * topology): Relu for every layer but the last, which is Softmax.
+ * @param layer layer's index
+ * @param numLayers number of layers in the network
+ * @return the layer's ActivationType
+ */
+ActivationType defaultActivation(const int layer, const int numLayers)
+{
+    return layer == numLayers - 1 ? Softmax : Relu;
+}
+
+/**
+ * reads a raw file of floats (the format of the original weight, bias and image files) into a given matrix in one
+ * read. exits with an error message when the file's size does not match the matrix's size.
+ * @param filePath path of the file to read
+ * @param m matrix to fill, already sized
+ */
+void readRawMatrixFile(const std::string &filePath, Matrix &m)
+{
+    std::ifstream ifStream(filePath, std::ios::in | std::ios::binary);
+    if (!ifStream.is_open())
+    {
+        std::cerr << "Error: could not open file " << filePath << std::endl;
+        exit(EXIT_CODE);
+    }
+    ifStream.seekg(0, std::ios::end);
+    const long fileSize = (long) ifStream.tellg();
+    ifStream.seekg(0, std::ios::beg);
+    const long expectedSize = (long) m.getRows() * m.getCols() * (long) sizeof(float);
+    if (fileSize != expectedSize)
+    {
+        std::cerr << "Error: file " << filePath << " has invalid size" << std::endl;
+        exit(EXIT_CODE);
+    }
+    for (int row = 0; row < m.getRows(); row++)
+    {
+        ifStream.read((char *) (m.getData() + (long) row * m.getLeadingDim()), m.getCols() * sizeof(float));
+    }
+}
+
+/**
+ * writes a matrix to a raw file of floats (the format readRawMatrixFile() reads), row after row. exits with an error
+ * message on failure.
+ * @param filePath path of the file to write
+ * @param m matrix to write
+ */
+void writeRawMatrixFile(const std::string &filePath, const Matrix &m)
+{
+    std::ofstream ofStream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    for (int row = 0; row < m.getRows() && ofStream; row++)
+    {
+        ofStream.write((const char *) (m.getData() + (long) row * m.getLeadingDim()), m.getCols() * sizeof(float));
+    }
+    if (!ofStream)
+    {
+        std::cerr << "Error: could not write file " << filePath << std::endl;
+        exit(EXIT_CODE);
+    }
+}
@@ -0,0 +1,168 @@
+// ModelBundle.h
+/**
+ * @file ModelBundle.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ModelBundle object class - single file, memory mapped model (all weights and biases of a network)
+ */
+
+#ifndef MODELBUNDLE_H
+#define MODELBUNDLE_H
+
+#include <cstdint>
+#include <string>
+#include "Matrix.h"
+#include "Activation.h"
+
+/**
+ * @def BUNDLE_MAGIC
+ * @brief first 8 bytes of every bundle file
+ */
+#define BUNDLE_MAGIC "MLPBNDL"
+
+/**
+ * @def BUNDLE_VERSION
+ * @brief version of the bundle format written by ModelBundle::write. version 1 bundles (no activation table) are
+ * still read, their layers get the default activations (see defaultActivation()).
+ */
+#define BUNDLE_VERSION 2
+
+/**
+ * @def BUNDLE_ALIGNMENT
+ * @brief alignment (in bytes, from the start of the file) of the tensor table and of every tensor
+ */
+#define BUNDLE_ALIGNMENT 64
+
+/**
+ * @struct BundleHeader
+ * @brief first 64 bytes of a bundle file. all integers and floats in a bundle are little endian.
+ * checksum - 64 bit FNV-1a over the little endian 64 bit words of everything after the header.
+ */
+typedef struct BundleHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numLayers;
+    uint64_t fileSize;
+    uint64_t checksum;
+    uint8_t reserved[32];
+} BundleHeader;
+
+/**
+ * @struct BundleTensor
+ * @brief entry of the tensor table that follows the header: layer i's weights are entry 2i, it's bias entry 2i + 1.
+ * offset - position of the tensor's rows * cols floats (row after row) from the start of the file.
+ * from version 2 the tensor table is followed by the activation table: one uint32 ActivationType per layer.
+ */
+typedef struct BundleTensor
+{
+    uint32_t rows;
+    uint32_t cols;
+    uint64_t offset;
+} BundleTensor;
+
+/**
+ * class of ModelBundle object: a bundle file mapped into memory. the weights and biases are handed out as Matrix
+ * views of the mapping, so loading a model reads no values up front and copies none - pages are read from the
+ * page cache on first use. the mapping is private, a write to a view copies only the written page.
+ */
+class ModelBundle
+{
+private:
+    void *mapping;
+    size_t mappingSize;
+    const BundleHeader *header;
+    const BundleTensor *tensors;
+    const uint32_t *activations;
+
+    /**
+     * returns a view of one entry of the tensor table
+     * @param index entry's index
+     * @return matrix viewing the tensor's values
+     */
+    Matrix tensorView(int index) const;
+
+public:
+    /**
+     * constructor for ModelBundle object: maps a bundle file and validates it (magic, version, size, alignment,
+     * bounds and overlap of every tensor, checksum). exits with an error message if the file is not a valid bundle.
+     * @param filePath path of the bundle file
+     * @param verifyChecksum whether to verify the checksum (which reads the whole file)
+     */
+    explicit ModelBundle(const std::string &filePath, bool verifyChecksum = true);
+
+    /**
+     * destructor for ModelBundle object: unmaps the file. every view handed out must be gone by then.
+     */
+    ~ModelBundle();
+
+    ModelBundle(const ModelBundle &other) = delete;
+
+    ModelBundle &operator=(const ModelBundle &other) = delete;
+
+    /**
+     * getter for the number of layers in the bundle
+     * @return number of layers
+     */
+    int getNumLayers() const;
+
+    /**
+     * returns a view of a layer's weights matrix
+     * @param layer layer's index
+     * @return matrix viewing the weights
+     */
+    Matrix getWeights(int layer) const;
+
+    /**
+     * returns a view of a layer's bias vector
+     * @param layer layer's index
+     * @return matrix viewing the bias
+     */
+    Matrix getBias(int layer) const;
+
+    /**
+     * getter for a layer's activation
+     * @param layer layer's index
+     * @return the layer's ActivationType
+     */
+    ActivationType getActivation(int layer) const;
+
+    /**
+     * writes a bundle file from given weights, biases and activations. exits with an error message on failure.
+     * @param filePath path of the bundle file to write
+     * @param weights array of numLayers matrices representing weights
+     * @param biases array of numLayers matrices representing biases
+     * @param numLayers number of layers
+     * @param activations array of numLayers activations, or nullptr for the default activations
+     */
+    static void write(const std::string &filePath, const Matrix weights[], const Matrix biases[], int numLayers,
+                      const ActivationType activations[] = nullptr);
+};
+
+/**
+ * returns the activation of a layer of a network that doesn't specify it's activations (the original MlpNetwork
+ * topology): Relu for every layer but the last, which is Softmax.
+ * @param layer layer's index
+ * @param numLayers number of layers in the network
+ * @return the layer's ActivationType
+ */
+ActivationType defaultActivation(int layer, int numLayers);
+
+/**
+ * reads a raw file of floats (the format of the original weight, bias and image files) into a given matrix in one
+ * read. exits with an error message when the file's size does not match the matrix's size.
+ * @param filePath path of the file to read
+ * @param m matrix to fill, already sized
+ */
+void readRawMatrixFile(const std::string &filePath, Matrix &m);
+
+/**
+ * writes a matrix to a raw file of floats (the format readRawMatrixFile() reads), row after row. exits with an error
+ * message on failure.
+ * @param filePath path of the file to write
+ * @param m matrix to write
+ */
+void writeRawMatrixFile(const std::string &filePath, const Matrix &m);
+
+#endif //MODELBUNDLE_H
@@ -0,0 +1,169 @@
+/**
+ * @file NetworkPlan.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief NetworkPlan object class - execution plan of a sequence of Dense layers, built once when a model is loaded.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <sstream>
+#include <utility>
+#include "NetworkPlan.h"
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * exits with an error message if the given layers don't form a network: every layer needs a bias of one column with
+ * a value per output, and as many inputs as the previous layer has outputs.
+ * @param layers network's layers, in order
+ */
+static void checkLayers(const std::vector<LayerSpec> &layers)
+{
+    if (layers.empty())
+    {
+        std::cerr << "Error: network has no layers" << std::endl;
+        exit(1);
+    }
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (i > 0 && layers[i].weights.getCols() != layers[i - 1].weights.getRows())
+        {
+            std::cerr << "Error: weights matrix has invalid rows or cols number" << std::endl;
+            exit(1);
+        }
+        if (layers[i].bias.getRows() != layers[i].weights.getRows() || layers[i].bias.getCols() != 1)
+        {
+            std::cerr << "Error: biases vector has invalid rows or cols number" << std::endl;
+            exit(1);
+        }
+    }
+}
+
+/**
+ * returns whether folding a layer into the next one (see NetworkPlan.h) makes the network cheaper
+ * @param first layer without activation
+ * @param second layer that follows it
+ * @return true if the folded layer has fewer weights than the two layers
+ */
+static bool worthFolding(const LayerSpec &first, const LayerSpec &second)
+{
+    const long folded = (long) second.weights.getRows() * first.weights.getCols();
+    const long separate = (long) first.weights.getRows() * first.weights.getCols() +
+                          (long) second.weights.getRows() * second.weights.getCols();
+    return first.activation == Identity && folded <= separate;
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for an empty NetworkPlan object (no layers)
+ */
+NetworkPlan::NetworkPlan() : inputSize(0), outputSize(0), bufferSize(0), foldedLayers(0), argmaxFused(false)
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * plans the given layers: checks that every layer's dimensions match the previous layer's, folds layers and fuses
+ * the last Softmax in place (the given layers become the layers to run, one per step). exits with an error message
+ * if the layers don't form a network.
+ * @param layers network's layers, in order
+ * @return the plan for the (possibly folded) layers
+ */
+NetworkPlan NetworkPlan::build(std::vector<LayerSpec> &layers)
+{
+    checkLayers(layers);
+    NetworkPlan plan;
+    for (size_t i = 0; i + 1 < layers.size();)
+    {
+        if (!worthFolding(layers[i], layers[i + 1]))
+        {
+            i++;
+            continue;
+        }
+        LayerSpec &first = layers[i], &second = layers[i + 1];
+        Matrix foldedBias = second.weights * first.bias + second.bias;
+        Matrix foldedWeights = second.weights * first.weights;
+        second.weights = std::move(foldedWeights);
+        second.bias = std::move(foldedBias);
+        layers.erase(layers.begin() + (long) i);
+        plan.foldedLayers++;
+    }
+    if (layers.back().activation == Softmax || layers.back().activation == LogSoftmax)
+    {
+        layers.back().activation = Identity;
+        plan.argmaxFused = true;
+    }
+    plan.inputSize = layers.front().weights.getCols();
+    plan.outputSize = layers.back().weights.getRows();
+    int input = NETWORK_INPUT;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const int output = (int) (i % PLAN_BUFFERS);
+        plan.steps.push_back({input, output});
+        plan.bufferSize = layers[i].weights.getRows() > plan.bufferSize ? layers[i].weights.getRows() : plan.bufferSize;
+        input = output;
+    }
+    return plan;
+}
+
+/**
+ * getter for the plan's steps (step i runs layer i)
+ * @return plan's steps
+ */
+const std::vector<PlanStep> &NetworkPlan::getSteps() const
+{
+    return this->steps;
+}
+
+/**
+ * getter for the number of values the network's input has
+ * @return network's input size
+ */
+int NetworkPlan::getInputSize() const
+{
+    return this->inputSize;
+}
+
+/**
+ * getter for the number of values the network's output has
+ * @return network's output size
+ */
+int NetworkPlan::getOutputSize() const
+{
+    return this->outputSize;
+}
+
+/**
+ * getter for the size (in values, per input vector) every ping-pong buffer needs
+ * @return buffer size
+ */
+int NetworkPlan::getBufferSize() const
+{
+    return this->bufferSize;
+}
+
+/**
+ * returns whether the last layer's Softmax was fused into the argmax (the last layer then outputs logits)
+ * @return true if the softmax is fused
+ */
+bool NetworkPlan::isArgmaxFused() const
+{
+    return this->argmaxFused;
+}
+
+/**
+ * returns a one line description of the plan, for logging
+ * @return description of the plan
+ */
+std::string NetworkPlan::describe() const
+{
+    std::ostringstream description;
+    description << steps.size() << " steps (" << foldedLayers << " layers folded), " << inputSize << " inputs, "
+                << outputSize << " outputs, " << PLAN_BUFFERS << " buffers of " << bufferSize << " values"
+                << (argmaxFused ? ", softmax fused into argmax" : "");
+    return description.str();
+}
@@ -0,0 +1,126 @@
+// NetworkPlan.h
+/**
+ * @file NetworkPlan.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief NetworkPlan object class - execution plan of a sequence of Dense layers, built once when a model is loaded.
+ *
+ * @section DESCRIPTION
+ * planning a network:
+ *  - folds adjacent layers when the first one has no activation (Identity): W2 * (W1 * x + b1) + b2 is one layer
+ *    (W2 * W1) * x + (W2 * b1 + b2), which is done whenever the folded layer has fewer weights than the two layers.
+ *  - fuses the last layer's Softmax (or LogSoftmax) into the argmax that picks the most probable digit: the last layer
+ *    is run without activation and the probability of the largest output is computed from it (see
+ *    mostProbableLogit()).
+ *  - assigns every layer's input and output to one of two ping-pong buffers, so running the network reuses two
+ *    buffers whatever it's depth.
+ *  - precomputes the size of the buffers (the largest layer output), so a workspace is allocated once.
+ * the bias and activation of every layer are fused into it's matrix product by Dense itself.
+ */
+
+#ifndef NETWORKPLAN_H
+#define NETWORKPLAN_H
+
+#include <string>
+#include <vector>
+#include "Matrix.h"
+#include "Activation.h"
+
+/**
+ * @def NETWORK_INPUT
+ * @brief buffer index of the network's input in a PlanStep
+ */
+#define NETWORK_INPUT (-1)
+
+/**
+ * @def PLAN_BUFFERS
+ * @brief number of ping-pong buffers a plan assigns the layer outputs to
+ */
+#define PLAN_BUFFERS 2
+
+/**
+ * @struct LayerSpec
+ * @brief description of one Dense layer of a network: it's weights, bias and activation.
+ */
+typedef struct LayerSpec
+{
+    Matrix weights;
+    Matrix bias;
+    ActivationType activation;
+} LayerSpec;
+
+/**
+ * @struct PlanStep
+ * @brief one step of a plan: runs the step's layer from inputBuffer (or NETWORK_INPUT) into outputBuffer.
+ */
+typedef struct PlanStep
+{
+    int inputBuffer;
+    int outputBuffer;
+} PlanStep;
+
+/**
+ * class of NetworkPlan object
+ */
+class NetworkPlan
+{
+private:
+    std::vector<PlanStep> steps;
+    int inputSize, outputSize, bufferSize;
+    int foldedLayers;
+    bool argmaxFused;
+
+public:
+    /**
+     * constructor for an empty NetworkPlan object (no layers)
+     */
+    NetworkPlan();
+
+    /**
+     * plans the given layers: checks that every layer's dimensions match the previous layer's, folds layers and
+     * fuses the last Softmax in place (the given layers become the layers to run, one per step). exits with an error
+     * message if the layers don't form a network.
+     * @param layers network's layers, in order
+     * @return the plan for the (possibly folded) layers
+     */
+    static NetworkPlan build(std::vector<LayerSpec> &layers);
+
+    /**
+     * getter for the plan's steps (step i runs layer i)
+     * @return plan's steps
+     */
+    const std::vector<PlanStep> &getSteps() const;
+
+    /**
+     * getter for the number of values the network's input has
+     * @return network's input size
+     */
+    int getInputSize() const;
+
+    /**
+     * getter for the number of values the network's output has
+     * @return network's output size
+     */
+    int getOutputSize() const;
+
+    /**
+     * getter for the size (in values, per input vector) every ping-pong buffer needs
+     * @return buffer size
+     */
+    int getBufferSize() const;
+
+    /**
+     * returns whether the last layer's Softmax was fused into the argmax (the last layer then outputs logits)
+     * @return true if the softmax is fused
+     */
+    bool isArgmaxFused() const;
+
+    /**
+     * returns a one line description of the plan, for logging
+     * @return description of the plan
+     */
+    std::string describe() const;
+};
+
+#endif //NETWORKPLAN_H
@@ -0,0 +1,154 @@
+/**
+ * @file Optimizer.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief Optimizer interface and it's SGD and Adam implementations - turn the gradients of a mini-batch into the
+ * steps the trained parameters move by.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cmath>
+#include "Optimizer.h"
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * returns the state matrix of a parameter, created (zeroed) with the gradient's dimensions on first use
+ * @param states states of every parameter
+ * @param parameter index of the parameter
+ * @param gradient gradient with respect to the parameter
+ * @return the parameter's state
+ */
+static Matrix &parameterState(std::vector<Matrix> &states, const int parameter, const Matrix &gradient)
+{
+    if ((int) states.size() <= parameter)
+    {
+        states.resize(parameter + 1);
+    }
+    Matrix &state = states[parameter];
+    if (state.getRows() != gradient.getRows() || state.getCols() != gradient.getCols())
+    {
+        state = Matrix(gradient.getRows(), gradient.getCols());
+    }
+    return state;
+}
+
+/**
+ * resizes a step matrix to the gradient's dimensions, unless it already has them
+ * @param step step matrix
+ * @param gradient gradient with respect to the parameter
+ */
+static void fitStep(Matrix &step, const Matrix &gradient)
+{
+    if (step.getRows() != gradient.getRows() || step.getCols() != gradient.getCols() ||
+        step.getLeadingDim() != step.getCols())
+    {
+        step = Matrix(gradient.getRows(), gradient.getCols(), NoInit);
+    }
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for SgdOptimizer object
+ * @param learningRate learning rate
+ * @param momentum momentum, 0 for plain SGD
+ */
+SgdOptimizer::SgdOptimizer(const float learningRate, const float momentum) : learningRate(learningRate),
+                                                                             momentum(momentum)
+{
+}
+
+/**
+ * constructor for AdamOptimizer object
+ * @param learningRate learning rate
+ * @param beta1 decay rate of the gradient's mean
+ * @param beta2 decay rate of the gradient's square mean
+ * @param epsilon value added to the square root of the square mean, so the step stays finite
+ */
+AdamOptimizer::AdamOptimizer(const float learningRate, const float beta1, const float beta2, const float epsilon) :
+        learningRate(learningRate), beta1(beta1), beta2(beta2), epsilon(epsilon)
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * computes the step a parameter moves by: v = momentum * v - learningRate * gradient
+ * @param parameter index of the parameter
+ * @param gradient gradient with respect to the parameter
+ * @param step output, the step to add to the parameter (resized to the gradient's dimensions)
+ */
+void SgdOptimizer::computeStep(const int parameter, const Matrix &gradient, Matrix &step)
+{
+    fitStep(step, gradient);
+    const int rows = gradient.getRows(), cols = gradient.getCols();
+    if (momentum == 0)
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            const float *gradientRow = gradient.getData() + (long) i * gradient.getLeadingDim();
+            float *stepRow = step.getData() + (long) i * cols;
+            for (int j = 0; j < cols; j++)
+            {
+                stepRow[j] = -learningRate * gradientRow[j];
+            }
+        }
+        return;
+    }
+    Matrix &velocity = parameterState(velocities, parameter, gradient);
+    for (int i = 0; i < rows; i++)
+    {
+        const float *gradientRow = gradient.getData() + (long) i * gradient.getLeadingDim();
+        float *velocityRow = velocity.getData() + (long) i * velocity.getLeadingDim();
+        float *stepRow = step.getData() + (long) i * cols;
+        for (int j = 0; j < cols; j++)
+        {
+            velocityRow[j] = momentum * velocityRow[j] - learningRate * gradientRow[j];
+            stepRow[j] = velocityRow[j];
+        }
+    }
+}
+
+/**
+ * computes the step a parameter moves by: m = beta1 * m + (1 - beta1) * gradient,
+ * v = beta2 * v + (1 - beta2) * gradient^2 and the step is -learningRate * m' / (sqrt(v') + epsilon), where
+ * m' = m / (1 - beta1^t) and v' = v / (1 - beta2^t) after t steps.
+ * @param parameter index of the parameter
+ * @param gradient gradient with respect to the parameter
+ * @param step output, the step to add to the parameter (resized to the gradient's dimensions)
+ */
+void AdamOptimizer::computeStep(const int parameter, const Matrix &gradient, Matrix &step)
+{
+    fitStep(step, gradient);
+    Matrix &mean = parameterState(means, parameter, gradient);
+    Matrix &squareMean = parameterState(squareMeans, parameter, gradient);
+    if ((int) steps.size() <= parameter)
+    {
+        steps.resize(parameter + 1, 0);
+    }
+    const long t = ++steps[parameter];
+    // the bias corrections are folded into the learning rate and epsilon: m' / (sqrt(v') + e) =
+    // (sqrt(c2) / c1) * m / (sqrt(v) + e * sqrt(c2)) with c1 = 1 - beta1^t and c2 = 1 - beta2^t
+    const float correction1 = 1 - (float) std::pow(beta1, (double) t);
+    const float correction2 = 1 - (float) std::pow(beta2, (double) t);
+    const float stepSize = learningRate * std::sqrt(correction2) / correction1;
+    const float correctedEpsilon = epsilon * std::sqrt(correction2);
+    const int rows = gradient.getRows(), cols = gradient.getCols();
+    for (int i = 0; i < rows; i++)
+    {
+        const float *gradientRow = gradient.getData() + (long) i * gradient.getLeadingDim();
+        float *meanRow = mean.getData() + (long) i * mean.getLeadingDim();
+        float *squareRow = squareMean.getData() + (long) i * squareMean.getLeadingDim();
+        float *stepRow = step.getData() + (long) i * cols;
+        for (int j = 0; j < cols; j++)
+        {
+            const float g = gradientRow[j];
+            meanRow[j] = beta1 * meanRow[j] + (1 - beta1) * g;
+            squareRow[j] = beta2 * squareRow[j] + (1 - beta2) * g * g;
+            stepRow[j] = -stepSize * meanRow[j] / (std::sqrt(squareRow[j]) + correctedEpsilon);
+        }
+    }
+}
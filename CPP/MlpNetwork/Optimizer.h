@@ -0,0 +1,96 @@
+// Optimizer.h
+/**
+ * @file Optimizer.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief Optimizer interface and it's SGD and Adam implementations - turn the gradients of a mini-batch into the
+ * steps the trained parameters move by.
+ */
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * class of Optimizer object - interface of the optimization algorithms. every trained parameter (a weights matrix
+ * or a bias vector) is identified by an index, under which the optimizer keeps it's state between steps.
+ */
+class Optimizer
+{
+public:
+    /**
+     * virtual destructor for Optimizer objects as needed due to inheritance and polymorphism.
+     */
+    virtual ~Optimizer() = default;
+
+    /**
+     * computes the step a parameter moves by, from the gradient of the mini-batch's mean loss with respect to it
+     * @param parameter index of the parameter
+     * @param gradient gradient with respect to the parameter
+     * @param step output, the step to add to the parameter (resized to the gradient's dimensions)
+     */
+    virtual void computeStep(int parameter, const Matrix &gradient, Matrix &step) = 0;
+};
+
+/**
+ * class of SgdOptimizer object - stochastic gradient descent with (optional) momentum:
+ * v = momentum * v - learningRate * gradient, and the step is v.
+ */
+class SgdOptimizer : public Optimizer
+{
+private:
+    float learningRate, momentum;
+    std::vector<Matrix> velocities;
+
+public:
+    /**
+     * constructor for SgdOptimizer object
+     * @param learningRate learning rate
+     * @param momentum momentum, 0 for plain SGD
+     */
+    explicit SgdOptimizer(float learningRate, float momentum = 0);
+
+    /**
+     * computes the step a parameter moves by, from the gradient of the mini-batch's mean loss with respect to it
+     * @param parameter index of the parameter
+     * @param gradient gradient with respect to the parameter
+     * @param step output, the step to add to the parameter (resized to the gradient's dimensions)
+     */
+    void computeStep(int parameter, const Matrix &gradient, Matrix &step) override;
+};
+
+/**
+ * class of AdamOptimizer object - Adam (Kingma & Ba): keeps running means of the gradient (m) and of it's square
+ * (v), and the step is -learningRate * m' / (sqrt(v') + epsilon) where m' and v' are the bias corrected means.
+ */
+class AdamOptimizer : public Optimizer
+{
+private:
+    float learningRate, beta1, beta2, epsilon;
+    std::vector<Matrix> means, squareMeans;
+    std::vector<long> steps;
+
+public:
+    /**
+     * constructor for AdamOptimizer object
+     * @param learningRate learning rate
+     * @param beta1 decay rate of the gradient's mean
+     * @param beta2 decay rate of the gradient's square mean
+     * @param epsilon value added to the square root of the square mean, so the step stays finite
+     */
+    explicit AdamOptimizer(float learningRate = 0.001f, float beta1 = 0.9f, float beta2 = 0.999f,
+                           float epsilon = 1e-8f);
+
+    /**
+     * computes the step a parameter moves by, from the gradient of the mini-batch's mean loss with respect to it
+     * @param parameter index of the parameter
+     * @param gradient gradient with respect to the parameter
+     * @param step output, the step to add to the parameter (resized to the gradient's dimensions)
+     */
+    void computeStep(int parameter, const Matrix &gradient, Matrix &step) override;
+};
+
+#endif //OPTIMIZER_H
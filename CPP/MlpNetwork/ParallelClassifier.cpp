@@ -0,0 +1,73 @@
+/**
+ * @file ParallelClassifier.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ParallelClassifier object class - classifies datasets of images on all cores
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include "ParallelClassifier.h"
+#include "MlpNetwork.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for ParallelClassifier object
+ * @param classifier classifier to run, must outlive the ParallelClassifier
+ * @param numThreads number of worker threads, 0 for one per hardware thread
+ */
+ParallelClassifier::ParallelClassifier(const DigitClassifier &classifier, const int numThreads) :
+        classifier(classifier), pool(numThreads)
+{
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the number of worker threads
+ * @return number of worker threads
+ */
+int ParallelClassifier::getNumThreads() const
+{
+    return pool.getNumThreads();
+}
+
+/**
+ * classifies every image of a dataset
+ * @param images vector of images, each image is a 28x28 matrix or a 784x1 vector
+ * @param miniBatchSize number of images per task, classified in one batched forward pass (1 - image by image)
+ * @return vector of Digit objects, the i'th Digit describes the i'th image
+ */
+std::vector<Digit> ParallelClassifier::classify(const std::vector<Matrix> &images, const int miniBatchSize) const
+{
+    const int imgSize = imgDims.rows * imgDims.cols;
+    std::vector<Digit> digitsToReturn(images.size());
+    pool.parallelFor((long) images.size(), miniBatchSize, [&](const long begin, const long end)
+    {
+        if (end - begin == 1)
+        {
+            digitsToReturn[begin] = classifier(images[begin]);
+            return;
+        }
+        const int batchSize = (int) (end - begin);
+        Matrix batch(imgSize, batchSize, NoInit);
+        for (int j = 0; j < batchSize; j++)
+        {
+            if (images[begin + j].getRows() * images[begin + j].getCols() != imgSize)
+            {
+                std::cerr << "Error: image in batch has invalid rows or cols number" << std::endl;
+                exit(1);
+            }
+            for (int i = 0; i < imgSize; i++)
+            {
+                batch.getData()[(long) i * batchSize + j] = images[begin + j].elementAt(i);
+            }
+        }
+        const std::vector<Digit> batchDigits = classifier.classifyBatch(batch);
+        std::copy(batchDigits.begin(), batchDigits.end(), digitsToReturn.begin() + begin);
+    });
+    return digitsToReturn;
+}
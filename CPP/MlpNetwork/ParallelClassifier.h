@@ -0,0 +1,56 @@
+// ParallelClassifier.h
+/**
+ * @file ParallelClassifier.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ParallelClassifier object class - classifies datasets of images on all cores
+ */
+
+#ifndef PARALLELCLASSIFIER_H
+#define PARALLELCLASSIFIER_H
+
+#include <vector>
+#include "DigitClassifier.h"
+#include "ThreadPool.h"
+
+/**
+ * @def PARALLEL_MINI_BATCH
+ * @brief default number of images classified together by one task
+ */
+#define PARALLEL_MINI_BATCH 32
+
+/**
+ * class of ParallelClassifier object: spreads mini-batches of images over a work stealing ThreadPool. every thread
+ * uses the same classifier (one read-only copy of the weights, each thread has it's own scratch buffers) and every
+ * result is written at it's image's index, so the results are in input order.
+ */
+class ParallelClassifier
+{
+private:
+    const DigitClassifier &classifier;
+    mutable ThreadPool pool;
+public:
+    /**
+     * constructor for ParallelClassifier object
+     * @param classifier classifier to run, must outlive the ParallelClassifier
+     * @param numThreads number of worker threads, 0 for one per hardware thread
+     */
+    explicit ParallelClassifier(const DigitClassifier &classifier, int numThreads = 0);
+
+    /**
+     * getter for the number of worker threads
+     * @return number of worker threads
+     */
+    int getNumThreads() const;
+
+    /**
+     * classifies every image of a dataset
+     * @param images vector of images, each image is a 28x28 matrix or a 784x1 vector
+     * @param miniBatchSize number of images per task, classified in one batched forward pass (1 - image by image)
+     * @return vector of Digit objects, the i'th Digit describes the i'th image
+     */
+    std::vector<Digit> classify(const std::vector<Matrix> &images, int miniBatchSize = PARALLEL_MINI_BATCH) const;
+};
+
+#endif //PARALLELCLASSIFIER_H
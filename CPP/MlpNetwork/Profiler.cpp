@@ -0,0 +1,532 @@
+/**
+ * @file Profiler.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief opt-in per-layer profiling of inference (see Profiler.h)
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "Profiler.h"
+
+#ifdef MLP_PROFILE
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#if defined(__linux__)
+#define PROFILE_PERF_EVENTS 1
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * printable names of the ProfilePhase values
+ */
+static const char *const PHASE_NAMES[] = {"total", "matmul", "bias", "activation"};
+
+/**
+ * printable names of the hardware counters
+ */
+static const char *const COUNTER_NAMES[] = {"cycles", "instructions", "llc_misses"};
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+#ifdef MLP_PROFILE
+
+/**
+ * class of ThreadProfile object - the measurements and hardware counters of one thread. the measurements are
+ * guarded by a mutex only the owning thread and a summary take, so it is never contended while profiling.
+ */
+class ThreadProfile
+{
+private:
+    std::vector<LayerProfile> layers;
+    int perfFds[PROFILE_COUNTERS];
+
+public:
+    std::mutex mutex;
+    int currentLayer;
+
+    /**
+     * constructor for ThreadProfile object: opens the hardware counters of the calling thread as one group (read
+     * together by one system call) and registers the profile
+     */
+    ThreadProfile();
+
+    /**
+     * destructor for ThreadProfile object: adds the thread's measurements to the retired threads' and unregisters
+     * the profile
+     */
+    ~ThreadProfile();
+
+    ThreadProfile(const ThreadProfile &other) = delete;
+
+    ThreadProfile &operator=(const ThreadProfile &other) = delete;
+
+    /**
+     * returns whether the hardware counters are open
+     * @return true if the counters are read
+     */
+    bool hasCounters() const
+    {
+        return perfFds[0] >= 0;
+    }
+
+    /**
+     * reads the clock and the hardware counters
+     * @param sample output sample
+     */
+    void read(ProfileSample &sample) const;
+
+    /**
+     * adds a measurement (caller holds mutex)
+     * @param layer layer of the measurement
+     * @param phase phase of the measurement
+     * @param start sample taken at the start of the measurement
+     * @param end sample taken at the end of the measurement
+     * @param bytes number of bytes the measured work touched
+     */
+    void add(int layer, ProfilePhase phase, const ProfileSample &start, const ProfileSample &end, long bytes);
+
+    /**
+     * adds the thread's measurements into given layer profiles (caller holds mutex)
+     * @param total layer profiles to add to
+     */
+    void addTo(std::vector<LayerProfile> &total) const;
+
+    /**
+     * clears the thread's measurements (caller holds mutex)
+     */
+    void clear()
+    {
+        layers.clear();
+    }
+};
+
+/**
+ * @struct ProfileRegistry
+ * @brief every live thread's profile and the measurements of the threads that exited
+ */
+typedef struct ProfileRegistry
+{
+    std::mutex mutex;
+    std::vector<ThreadProfile *> threads;
+    std::vector<LayerProfile> retired;
+} ProfileRegistry;
+
+/**
+ * returns the registry, created on first use (before the first ThreadProfile, so destroyed after the last one)
+ * @return the registry
+ */
+static ProfileRegistry &registry()
+{
+    static ProfileRegistry profileRegistry;
+    return profileRegistry;
+}
+
+/**
+ * returns the calling thread's profile
+ * @return the calling thread's profile
+ */
+static ThreadProfile &threadProfile()
+{
+    static thread_local ThreadProfile profile;
+    return profile;
+}
+
+/**
+ * returns a layer's profile in a vector of layer profiles, added (zeroed) if it isn't there yet
+ * @param profiles layer profiles, ordered by layer
+ * @param layer layer
+ * @return the layer's profile
+ */
+static LayerProfile &layerProfile(std::vector<LayerProfile> &profiles, const int layer)
+{
+    auto position = std::lower_bound(profiles.begin(), profiles.end(), layer,
+                                     [](const LayerProfile &profile, int value) { return profile.layer < value; });
+    if (position == profiles.end() || position->layer != layer)
+    {
+        LayerProfile profile;
+        std::memset(&profile, 0, sizeof(profile));
+        profile.layer = layer;
+        position = profiles.insert(position, profile);
+    }
+    return *position;
+}
+
+/**
+ * adds the measurements of given layer profiles into other layer profiles
+ * @param from layer profiles to add
+ * @param to layer profiles to add to
+ */
+static void addProfiles(const std::vector<LayerProfile> &from, std::vector<LayerProfile> &to)
+{
+    for (const LayerProfile &profile : from)
+    {
+        LayerProfile &total = layerProfile(to, profile.layer);
+        for (int p = 0; p < PROFILE_PHASES; p++)
+        {
+            total.phases[p].calls += profile.phases[p].calls;
+            total.phases[p].wallNs += profile.phases[p].wallNs;
+            total.phases[p].bytes += profile.phases[p].bytes;
+            for (int c = 0; c < PROFILE_COUNTERS; c++)
+            {
+                total.phases[p].counters[c] += profile.phases[p].counters[c];
+            }
+        }
+    }
+}
+
+#ifdef PROFILE_PERF_EVENTS
+
+/**
+ * opens one hardware counter of the calling thread, counting user space only
+ * @param config PERF_COUNT_HW_ value of the counter
+ * @param groupFd file descriptor of the group's leader, or -1 to open the leader
+ * @return the counter's file descriptor, or -1 if it can't be opened
+ */
+static int openCounter(const uint64_t config, const int groupFd)
+{
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+#endif
+
+/**
+ * constructor for ThreadProfile object: opens the hardware counters of the calling thread as one group (read
+ * together by one system call) and registers the profile
+ */
+ThreadProfile::ThreadProfile() : currentLayer(-1)
+{
+    std::fill(perfFds, perfFds + PROFILE_COUNTERS, -1);
+#ifdef PROFILE_PERF_EVENTS
+    const uint64_t configs[PROFILE_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                PERF_COUNT_HW_CACHE_MISSES};
+    int fds[PROFILE_COUNTERS];
+    bool opened = true;
+    for (int c = 0; c < PROFILE_COUNTERS; c++)
+    {
+        fds[c] = opened ? openCounter(configs[c], c == 0 ? -1 : fds[0]) : -1;
+        opened = opened && fds[c] >= 0;
+    }
+    for (int c = PROFILE_COUNTERS - 1; c >= 0 && !opened; c--)
+    {
+        if (fds[c] >= 0)
+        {
+            close(fds[c]);
+        }
+    }
+    if (opened)
+    {
+        std::copy(fds, fds + PROFILE_COUNTERS, perfFds);
+    }
+#endif
+    ProfileRegistry &profileRegistry = registry();
+    std::lock_guard<std::mutex> lock(profileRegistry.mutex);
+    profileRegistry.threads.push_back(this);
+}
+
+/**
+ * destructor for ThreadProfile object: adds the thread's measurements to the retired threads' and unregisters
+ * the profile
+ */
+ThreadProfile::~ThreadProfile()
+{
+    ProfileRegistry &profileRegistry = registry();
+    {
+        std::lock_guard<std::mutex> lock(profileRegistry.mutex);
+        addProfiles(layers, profileRegistry.retired);
+        profileRegistry.threads.erase(std::find(profileRegistry.threads.begin(), profileRegistry.threads.end(), this));
+    }
+#ifdef PROFILE_PERF_EVENTS
+    // every event of the group has it's own descriptor, the members' are closed before the leader's
+    for (int c = PROFILE_COUNTERS - 1; c >= 0; c--)
+    {
+        if (perfFds[c] >= 0)
+        {
+            close(perfFds[c]);
+        }
+    }
+#endif
+}
+
+/**
+ * reads the clock and the hardware counters
+ * @param sample output sample
+ */
+void ThreadProfile::read(ProfileSample &sample) const
+{
+    std::memset(sample.counters, 0, sizeof(sample.counters));
+#ifdef PROFILE_PERF_EVENTS
+    if (perfFds[0] >= 0)
+    {
+        uint64_t values[1 + PROFILE_COUNTERS];
+        if (::read(perfFds[0], values, sizeof(values)) == (ssize_t) sizeof(values))
+        {
+            std::memcpy(sample.counters, values + 1, sizeof(sample.counters));
+        }
+    }
+#endif
+    sample.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * adds a measurement (caller holds mutex). a phase's bytes are added to it's layer's total too.
+ * @param layer layer of the measurement
+ * @param phase phase of the measurement
+ * @param start sample taken at the start of the measurement
+ * @param end sample taken at the end of the measurement
+ * @param bytes number of bytes the measured work touched
+ */
+void ThreadProfile::add(const int layer, const ProfilePhase phase, const ProfileSample &start, const ProfileSample &end,
+                        const long bytes)
+{
+    LayerProfile &profile = layerProfile(layers, layer);
+    ProfileStats &stats = profile.phases[phase];
+    stats.calls++;
+    stats.wallNs += (double) (end.ns - start.ns);
+    stats.bytes += bytes;
+    profile.phases[LayerTotalPhase].bytes += phase == LayerTotalPhase ? 0 : bytes;
+    for (int c = 0; c < PROFILE_COUNTERS; c++)
+    {
+        stats.counters[c] += end.counters[c] - start.counters[c];
+    }
+}
+
+/**
+ * adds the thread's measurements into given layer profiles (caller holds mutex)
+ * @param total layer profiles to add to
+ */
+void ThreadProfile::addTo(std::vector<LayerProfile> &total) const
+{
+    addProfiles(layers, total);
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for ProfileScope object - starts measuring
+ * @param layer layer to attribute the measurement to, or -1 for the calling thread's current layer
+ * @param phase phase to attribute the measurement to
+ * @param bytes number of bytes the measured work reads and writes (0 for a LayerTotalPhase scope)
+ */
+ProfileScope::ProfileScope(const int layer, const ProfilePhase phase, const long bytes) : layer(layer),
+                                                                                         previousLayer(-1),
+                                                                                         phase(phase), bytes(bytes)
+{
+    ThreadProfile &profile = threadProfile();
+    if (phase == LayerTotalPhase)
+    {
+        previousLayer = profile.currentLayer;
+        profile.currentLayer = layer;
+    }
+    else
+    {
+        this->layer = profile.currentLayer;
+    }
+    profile.read(start);
+}
+
+/**
+ * destructor for ProfileScope object - adds the measurement to the calling thread's counters
+ */
+ProfileScope::~ProfileScope()
+{
+    ThreadProfile &profile = threadProfile();
+    ProfileSample end;
+    profile.read(end);
+    {
+        std::lock_guard<std::mutex> lock(profile.mutex);
+        profile.add(layer, phase, start, end, bytes);
+    }
+    if (phase == LayerTotalPhase)
+    {
+        profile.currentLayer = previousLayer;
+    }
+}
+
+#endif
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * returns whether profiling was compiled in (MLP_PROFILE)
+ * @return true if the PROFILE_ macros record measurements
+ */
+bool Profiler::isCompiledIn()
+{
+#ifdef MLP_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * returns whether the hardware counters could be opened on the calling thread
+ * @return true if cycles, instructions and cache misses are recorded
+ */
+bool Profiler::countersAvailable()
+{
+#ifdef MLP_PROFILE
+    return threadProfile().hasCounters();
+#else
+    return false;
+#endif
+}
+
+/**
+ * returns the measurements recorded so far, summed over every thread, ordered by layer
+ * @return one LayerProfile per layer that was run
+ */
+std::vector<LayerProfile> Profiler::summary()
+{
+    std::vector<LayerProfile> total;
+#ifdef MLP_PROFILE
+    ProfileRegistry &profileRegistry = registry();
+    std::lock_guard<std::mutex> lock(profileRegistry.mutex);
+    total = profileRegistry.retired;
+    for (ThreadProfile *profile : profileRegistry.threads)
+    {
+        std::lock_guard<std::mutex> threadLock(profile->mutex);
+        profile->addTo(total);
+    }
+#endif
+    return total;
+}
+
+/**
+ * clears the measurements recorded so far
+ */
+void Profiler::reset()
+{
+#ifdef MLP_PROFILE
+    ProfileRegistry &profileRegistry = registry();
+    std::lock_guard<std::mutex> lock(profileRegistry.mutex);
+    profileRegistry.retired.clear();
+    for (ThreadProfile *profile : profileRegistry.threads)
+    {
+        std::lock_guard<std::mutex> threadLock(profile->mutex);
+        profile->clear();
+    }
+#endif
+}
+
+/**
+ * prints the measurements as a table, a row per layer and phase
+ * @param os stream to print to
+ */
+void Profiler::printSummary(std::ostream &os)
+{
+    if (!isCompiledIn())
+    {
+        os << "profiling is compiled out (build with make PROFILE=1)" << std::endl;
+        return;
+    }
+    const bool counters = countersAvailable();
+    os << std::left << std::setw(7) << "layer" << std::setw(12) << "phase" << std::right << std::setw(10) << "calls"
+       << std::setw(12) << "total ms" << std::setw(12) << "us/call" << std::setw(10) << "GB/s";
+    if (counters)
+    {
+        os << std::setw(16) << "cycles" << std::setw(16) << "instructions" << std::setw(7) << "IPC" << std::setw(14)
+           << "llc misses";
+    }
+    os << std::endl;
+    for (const LayerProfile &profile : summary())
+    {
+        for (int p = 0; p < PROFILE_PHASES; p++)
+        {
+            const ProfileStats &stats = profile.phases[p];
+            if (stats.calls == 0)
+            {
+                continue;
+            }
+            os << std::left << std::setw(7) << (profile.layer < 0 ? std::string("-") : std::to_string(profile.layer))
+               << std::setw(12) << PHASE_NAMES[p] << std::right << std::fixed << std::setw(10) << stats.calls
+               << std::setprecision(3) << std::setw(12) << stats.wallNs / 1e6 << std::setw(12)
+               << stats.wallNs / 1e3 / (double) stats.calls << std::setprecision(2) << std::setw(10)
+               << (stats.wallNs > 0 ? (double) stats.bytes / stats.wallNs : 0);
+            if (counters)
+            {
+                os << std::setw(16) << stats.counters[0] << std::setw(16) << stats.counters[1] << std::setw(7)
+                   << (stats.counters[0] ? (double) stats.counters[1] / (double) stats.counters[0] : 0)
+                   << std::setw(14) << stats.counters[2];
+            }
+            os << std::endl;
+        }
+    }
+    if (!counters)
+    {
+        os << "hardware counters unavailable (perf_event_open failed)" << std::endl;
+    }
+}
+
+/**
+ * writes the measurements as JSON. the counters are null when they are unavailable. exits with an error message on
+ * failure.
+ * @param filePath path of the file to write
+ */
+void Profiler::writeJson(const std::string &filePath)
+{
+    std::ofstream ofStream(filePath, std::ios::out | std::ios::trunc);
+    const bool counters = countersAvailable();
+    ofStream << "{\n  \"compiled_in\": " << (isCompiledIn() ? "true" : "false") << ",\n  \"counters_available\": "
+             << (counters ? "true" : "false") << ",\n  \"layers\": [";
+    const std::vector<LayerProfile> profiles = summary();
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        ofStream << (i == 0 ? "\n" : ",\n") << "    {\"layer\": " << profiles[i].layer << ", \"phases\": {";
+        bool first = true;
+        for (int p = 0; p < PROFILE_PHASES; p++)
+        {
+            const ProfileStats &stats = profiles[i].phases[p];
+            if (stats.calls == 0)
+            {
+                continue;
+            }
+            ofStream << (first ? "" : ", ") << "\"" << PHASE_NAMES[p] << "\": {\"calls\": " << stats.calls
+                     << ", \"wall_ns\": " << std::fixed << std::setprecision(0) << stats.wallNs << ", \"bytes\": "
+                     << stats.bytes;
+            for (int c = 0; c < PROFILE_COUNTERS; c++)
+            {
+                ofStream << ", \"" << COUNTER_NAMES[c] << "\": ";
+                if (counters)
+                {
+                    ofStream << stats.counters[c];
+                }
+                else
+                {
+                    ofStream << "null";
+                }
+            }
+            ofStream << "}";
+            first = false;
+        }
+        ofStream << "}}";
+    }
+    ofStream << "\n  ]\n}" << std::endl;
+    if (!ofStream)
+    {
+        std::cerr << "Error: could not write file " << filePath << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
@@ -0,0 +1,174 @@
+// Profiler.h
+/**
+ * @file Profiler.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief opt-in per-layer profiling of inference: wall time, calls and bytes touched of every layer and of every
+ * phase of a layer (matrix product, bias, activation), and the cycles, instructions and last level cache misses
+ * read with perf_event_open when the kernel allows it.
+ *
+ * @section DESCRIPTION
+ * profiling is compiled in only when MLP_PROFILE is defined (make PROFILE=1, after make clean). otherwise the
+ * PROFILE_LAYER and PROFILE_PHASE macros expand to nothing, so the instrumented code is exactly the code without
+ * them, and Profiler's functions report that profiling is compiled out.
+ * every thread records into it's own counters (no locking on the measured path). the summary sums every thread,
+ * and should be taken while no inference is running.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ProfilePhase
+ * @brief part of a layer's work a measurement is attributed to. LayerTotalPhase is the whole layer.
+ */
+enum ProfilePhase
+{
+    LayerTotalPhase,
+    MatmulPhase,
+    BiasPhase,
+    ActivationPhase
+};
+
+/**
+ * @def PROFILE_PHASES
+ * @brief number of ProfilePhase values
+ */
+#define PROFILE_PHASES 4
+
+/**
+ * @def PROFILE_COUNTERS
+ * @brief number of hardware counters read: cycles, instructions and last level cache misses
+ */
+#define PROFILE_COUNTERS 3
+
+/**
+ * @struct ProfileStats
+ * @brief accumulated measurements of one phase of one layer. the bytes of LayerTotalPhase are the sum of the bytes
+ * of the layer's phases.
+ */
+typedef struct ProfileStats
+{
+    long calls;
+    double wallNs;
+    long bytes;
+    uint64_t counters[PROFILE_COUNTERS];
+} ProfileStats;
+
+/**
+ * @struct LayerProfile
+ * @brief accumulated measurements of one layer, a ProfileStats per ProfilePhase. layer -1 holds the work done
+ * outside of a layer scope (e.g. a Dense run directly).
+ */
+typedef struct LayerProfile
+{
+    int layer;
+    ProfileStats phases[PROFILE_PHASES];
+} LayerProfile;
+
+/**
+ * class of Profiler object - access to the recorded measurements. only static functions.
+ */
+class Profiler
+{
+private:
+    Profiler() = default; // constructor declared default because there is no need to enable the user to
+    // create one - the measurements are accessed through public static functions below.
+public:
+    /**
+     * returns whether profiling was compiled in (MLP_PROFILE)
+     * @return true if the PROFILE_ macros record measurements
+     */
+    static bool isCompiledIn();
+
+    /**
+     * returns whether the hardware counters could be opened on the calling thread
+     * @return true if cycles, instructions and cache misses are recorded
+     */
+    static bool countersAvailable();
+
+    /**
+     * returns the measurements recorded so far, summed over every thread, ordered by layer
+     * @return one LayerProfile per layer that was run
+     */
+    static std::vector<LayerProfile> summary();
+
+    /**
+     * clears the measurements recorded so far
+     */
+    static void reset();
+
+    /**
+     * prints the measurements as a table, a row per layer and phase
+     * @param os stream to print to
+     */
+    static void printSummary(std::ostream &os);
+
+    /**
+     * writes the measurements as JSON. exits with an error message on failure.
+     * @param filePath path of the file to write
+     */
+    static void writeJson(const std::string &filePath);
+};
+
+#ifdef MLP_PROFILE
+
+/**
+ * @struct ProfileSample
+ * @brief clock and hardware counters read at the start of a scope
+ */
+typedef struct ProfileSample
+{
+    int64_t ns;
+    uint64_t counters[PROFILE_COUNTERS];
+} ProfileSample;
+
+/**
+ * class of ProfileScope object - measures the time between it's construction and destruction into a phase of the
+ * calling thread's current layer. a LayerTotalPhase scope also makes it's layer the current layer while it lives.
+ */
+class ProfileScope
+{
+private:
+    int layer, previousLayer;
+    ProfilePhase phase;
+    long bytes;
+    ProfileSample start;
+public:
+    /**
+     * constructor for ProfileScope object - starts measuring
+     * @param layer layer to attribute the measurement to, or -1 for the calling thread's current layer
+     * @param phase phase to attribute the measurement to
+     * @param bytes number of bytes the measured work reads and writes (0 for a LayerTotalPhase scope)
+     */
+    ProfileScope(int layer, ProfilePhase phase, long bytes);
+
+    /**
+     * destructor for ProfileScope object - adds the measurement to the calling thread's counters
+     */
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &other) = delete;
+
+    ProfileScope &operator=(const ProfileScope &other) = delete;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_LAYER(layer) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)((layer), LayerTotalPhase, 0)
+#define PROFILE_PHASE(phase, bytes) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(-1, (phase), (bytes))
+
+#else
+
+#define PROFILE_LAYER(layer) ((void) 0)
+#define PROFILE_PHASE(phase, bytes) ((void) 0)
+
+#endif
+
+#endif //PROFILER_H
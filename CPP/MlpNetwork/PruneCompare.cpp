@@ -0,0 +1,153 @@
+/**
+ * @file PruneCompare.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief program to prune the MlpNetwork's weights by magnitude and compare the pruned (sparse) network with the
+ * float network on a set of images: prints every layer's sparsity, how often the pruned network agrees with the float
+ * network and the time of the first layer, dense and sparse.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "MlpNetwork.h"
+#include "SparseMlpNetwork.h"
+
+// -------------------------- const definitions -------------------------
+
+#define FIRST_IMAGE_ARG (2 + 2 * MLP_SIZE)
+#define USAGE_MSG "Usage: prunecompare threshold|sparsity% w1 w2 w3 w4 b1 b2 b3 b4 image1 [image2 ...]\n" \
+                  "       (threshold prunes the weights of smaller magnitude in every layer, sparsity% prunes that\n" \
+                  "       percentage of the weights of every layer)"
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns the time it takes to run a function, in seconds
+ * @param function function to run
+ * @return time it took in seconds
+ */
+template<typename Function>
+double timed(const Function &function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc <= FIRST_IMAGE_ARG)
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string pruning = argv[1];
+    const bool bySparsity = !pruning.empty() && pruning.back() == '%';
+    const float pruningValue = std::strtof(pruning.c_str(), nullptr);
+    Matrix weights[MLP_SIZE], biases[MLP_SIZE];
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        weights[i] = Matrix(weightsDims[i].rows, weightsDims[i].cols);
+        biases[i] = Matrix(biasDims[i].rows, biasDims[i].cols);
+        readRawMatrixFile(argv[2 + i], weights[i]);
+        readRawMatrixFile(argv[2 + MLP_SIZE + i], biases[i]);
+    }
+    std::vector<Matrix> images;
+    Matrix batch(imgDims.rows * imgDims.cols, argc - FIRST_IMAGE_ARG);
+    for (int i = FIRST_IMAGE_ARG; i < argc; i++)
+    {
+        images.emplace_back(imgDims.rows, imgDims.cols);
+        readRawMatrixFile(argv[i], images.back());
+        for (int j = 0; j < batch.getRows(); j++)
+        {
+            batch.getData()[(long) j * batch.getCols() + (i - FIRST_IMAGE_ARG)] = images.back()[j];
+        }
+    }
+
+    float thresholds[MLP_SIZE];
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        thresholds[i] = bySparsity ? sparsityThreshold(weights[i], pruningValue / 100) : pruningValue;
+    }
+    const MlpNetwork floatNetwork(weights, biases);
+    const SparseMlpNetwork sparseNetwork(weights, biases, thresholds);
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        const SparseDense &layer = sparseNetwork.getLayer(i);
+        std::cout << "layer " << i << ": threshold " << thresholds[i] << ", " << layer.getNonZeros() << "/"
+                  << (long) layer.getRows() * layer.getCols() << " weights kept (" << 100 * layer.getSparsity()
+                  << "% sparse)" << std::endl;
+    }
+
+    std::vector<Digit> floatDigits, sparseDigits;
+    const double floatSeconds = timed([&]
+                                      {
+                                          for (const Matrix &img : images)
+                                          {
+                                              floatDigits.push_back(floatNetwork(img));
+                                          }
+                                      });
+    const double sparseSeconds = timed([&]
+                                       {
+                                           for (const Matrix &img : images)
+                                           {
+                                               sparseDigits.push_back(sparseNetwork(img));
+                                           }
+                                       });
+    int agreements = 0;
+    float sumProbDelta = 0, maxProbDelta = 0;
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        if (floatDigits[i].value == sparseDigits[i].value)
+        {
+            agreements++;
+            const float probDelta = std::fabs(floatDigits[i].probability - sparseDigits[i].probability);
+            sumProbDelta += probDelta;
+            maxProbDelta = std::fmax(maxProbDelta, probDelta);
+        }
+    }
+    std::cout << "images: " << images.size() << std::endl;
+    std::cout << "float32: " << 1e6 * floatSeconds / images.size() << " us/image" << std::endl;
+    std::cout << "sparse: " << 1e6 * sparseSeconds / images.size() << " us/image, agreement " << agreements << "/"
+              << images.size() << " (accuracy delta " << 100.0 * (agreements - (long) images.size()) / images.size()
+              << "% against float32), probability delta (agreeing images) mean "
+              << (agreements ? sumProbDelta / agreements : 0) << ", max " << maxProbDelta << std::endl;
+
+    // the first layer alone, as it holds most of the network's weights
+    const Dense &denseLayer = floatNetwork.getLayer(0);
+    const SparseDense &sparseLayer = sparseNetwork.getLayer(0);
+    std::vector<float> out(denseLayer.getWeights().getRows());
+    const double denseLayerSeconds = timed([&]
+                                           {
+                                               for (const Matrix &img : images)
+                                               {
+                                                   denseLayer.apply(img.getData(), out.data());
+                                               }
+                                           });
+    const double sparseLayerSeconds = timed([&]
+                                            {
+                                                for (const Matrix &img : images)
+                                                {
+                                                    sparseLayer.apply(img.getData(), out.data());
+                                                }
+                                            });
+    const double denseBatchSeconds = timed([&] { denseLayer(batch); });
+    const double sparseBatchSeconds = timed([&] { sparseLayer(batch); });
+    std::cout << "layer 0: dense " << 1e6 * denseLayerSeconds / images.size() << " us/image, sparse "
+              << 1e6 * sparseLayerSeconds / images.size() << " us/image; batch of " << images.size() << ": dense "
+              << 1e6 * denseBatchSeconds << " us, sparse " << 1e6 * sparseBatchSeconds << " us" << std::endl;
+    return 0;
+}
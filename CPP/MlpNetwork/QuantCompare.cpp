@@ -0,0 +1,121 @@
+/**
+ * @file QuantCompare.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief program to compare the float MlpNetwork with it's reduced precision variants (int8, fp16, bf16) on a set of
+ * images: prints the int8 quantization error of every layer's weights, how often every variant agrees with the float
+ * network and their inference time.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "MlpNetwork.h"
+#include "QuantizedMlpNetwork.h"
+#include "ModelBundle.h"
+
+// -------------------------- const definitions -------------------------
+
+#define FIRST_IMAGE_ARG (1 + 2 * MLP_SIZE)
+#define USAGE_MSG "Usage: quantcompare w1 w2 w3 w4 b1 b2 b3 b4 image1 [image2 ...]"
+
+/**
+ * printable names of the InferencePrecision values
+ */
+const char *const PRECISION_NAMES[] = {"float32", "int8", "fp16", "bf16"};
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * classifies every image with a given classifier
+ * @param classifier classifier to run
+ * @param images images to classify
+ * @param digits output vector, filled with the i'th image's Digit at index i
+ * @return time it took in seconds
+ */
+double classifyTimed(const DigitClassifier &classifier, const std::vector<Matrix> &images, std::vector<Digit> &digits)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (const Matrix &img : images)
+    {
+        digits.push_back(classifier(img));
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * main function that runs the program.
+ * @param argc number of system arguments given to the program.
+ * @param argv pointer to an array of strings presenting the system arguments given to the program.
+ * @return 0 in case program ended successfully, EXIT_FAILURE code otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc <= FIRST_IMAGE_ARG)
+    {
+        std::cerr << USAGE_MSG << std::endl;
+        return EXIT_FAILURE;
+    }
+    Matrix weights[MLP_SIZE], biases[MLP_SIZE];
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        weights[i] = Matrix(weightsDims[i].rows, weightsDims[i].cols);
+        biases[i] = Matrix(biasDims[i].rows, biasDims[i].cols);
+        readRawMatrixFile(argv[1 + i], weights[i]);
+        readRawMatrixFile(argv[1 + MLP_SIZE + i], biases[i]);
+    }
+    std::vector<Matrix> images;
+    for (int i = FIRST_IMAGE_ARG; i < argc; i++)
+    {
+        images.emplace_back(imgDims.rows, imgDims.cols);
+        readRawMatrixFile(argv[i], images.back());
+    }
+
+    QuantizedMlpNetwork int8Network(weights, biases);
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        const Matrix dequantized = int8Network.getLayer(i).dequantizedWeights();
+        float maxError = 0;
+        for (int j = 0; j < weights[i].getRows() * weights[i].getCols(); j++)
+        {
+            maxError = std::fmax(maxError, std::fabs(dequantized[j] - weights[i][j]));
+        }
+        std::cout << "layer " << i << ": max weight quantization error " << maxError << std::endl;
+    }
+
+    std::cout << "images: " << images.size() << std::endl;
+    const std::unique_ptr<DigitClassifier> floatNetwork =
+            ClassifierFactory::createClassifier(weights, biases, Float32Precision);
+    std::vector<Digit> floatDigits;
+    const double floatSeconds = classifyTimed(*floatNetwork, images, floatDigits);
+    std::cout << PRECISION_NAMES[Float32Precision] << ": " << 1e6 * floatSeconds / images.size() << " us/image"
+              << std::endl;
+    for (InferencePrecision precision : {Int8Precision, Float16Precision, BFloat16Precision})
+    {
+        const std::unique_ptr<DigitClassifier> network = ClassifierFactory::createClassifier(weights, biases,
+                                                                                             precision);
+        std::vector<Digit> digits;
+        const double seconds = classifyTimed(*network, images, digits);
+        int agreements = 0;
+        float sumProbDelta = 0, maxProbDelta = 0;
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            if (floatDigits[i].value == digits[i].value)
+            {
+                agreements++;
+                const float probDelta = std::fabs(floatDigits[i].probability - digits[i].probability);
+                sumProbDelta += probDelta;
+                maxProbDelta = std::fmax(maxProbDelta, probDelta);
+            }
+        }
+        std::cout << PRECISION_NAMES[precision] << ": " << 1e6 * seconds / images.size() << " us/image, agreement "
+                  << agreements << "/" << images.size() << " (" << 100.0 * agreements / images.size()
+                  << "%), probability delta (agreeing images) mean "
+                  << (agreements ? sumProbDelta / agreements : 0) << ", max " << maxProbDelta << std::endl;
+    }
+    return 0;
+}
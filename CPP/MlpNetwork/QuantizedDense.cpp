@@ -0,0 +1,237 @@
+/**
+ * @file QuantizedDense.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief QuantizedDense object class - Dense layer with post-training int8 quantized weights
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cmath>
+#include "QuantizedDense.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define QUANTIZED_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * @def INT8_LEVELS
+ * @brief largest magnitude of a symmetric int8 quantized value
+ */
+#define INT8_LEVELS 127.0f
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * int8 dot product compiled for the baseline ISA of the build
+ */
+static int32_t dotInt8Generic(const int8_t *a, const int8_t *b, const long n)
+{
+    int32_t result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += (int16_t) a[i] * (int16_t) b[i];
+    }
+    return result;
+}
+
+#ifdef QUANTIZED_X86_DISPATCH
+
+/**
+ * int8 dot product for AVX2: 16 int8 pairs are sign extended to int16 and multiplied and pairwise added into int32
+ * lanes by pmaddwd, so the sum is exact (no int16 saturation as with pmaddubsw).
+ */
+__attribute__((target("avx2")))
+static int32_t dotInt8Avx2(const int8_t *a, const int8_t *b, const long n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256i a16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *) (a + i)));
+        const __m256i b16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *) (b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a16, b16));
+    }
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i *) lanes, acc);
+    int32_t result = 0;
+    for (int lane = 0; lane < 8; lane++)
+    {
+        result += lanes[lane];
+    }
+    return result + dotInt8Generic(a + i, b + i, n - i);
+}
+
+/**
+ * int8 dot product for AVX-512 VNNI: 32 int8 pairs are sign extended to int16 and accumulated into int32 lanes by
+ * one vpdpwssd instruction.
+ */
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+static int32_t dotInt8Vnni(const int8_t *a, const int8_t *b, const long n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    long i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m512i a16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *) (a + i)));
+        const __m512i b16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *) (b + i)));
+        acc = _mm512_dpwssd_epi32(acc, a16, b16);
+    }
+    int32_t lanes[16];
+    _mm512_storeu_si512((void *) lanes, acc);
+    int32_t result = 0;
+    for (int lane = 0; lane < 16; lane++)
+    {
+        result += lanes[lane];
+    }
+    return result + dotInt8Avx2(a + i, b + i, n - i);
+}
+
+#endif
+
+/**
+ * pointer type of the int8 dot product versions
+ */
+typedef int32_t (*DotInt8Func)(const int8_t *a, const int8_t *b, long n);
+
+/**
+ * picks the widest int8 dot product the host cpu supports
+ * @return pointer to the chosen dot product
+ */
+static DotInt8Func selectDotInt8()
+{
+#ifdef QUANTIZED_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx2"))
+    {
+        return dotInt8Vnni;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return dotInt8Avx2;
+    }
+#endif
+    return dotInt8Generic;
+}
+
+/**
+ * quantizes given values to int8 with one symmetric scale
+ * @param values values to quantize
+ * @param size number of values
+ * @param quantized output buffer of size int8 values
+ * @return the scale - values[i] ~ scale * quantized[i]
+ */
+static float quantizeSymmetric(const float *values, const long size, int8_t *quantized)
+{
+    float maxAbs = 0;
+    for (long i = 0; i < size; i++)
+    {
+        maxAbs = std::fabs(values[i]) > maxAbs ? std::fabs(values[i]) : maxAbs;
+    }
+    if (maxAbs == 0)
+    {
+        for (long i = 0; i < size; i++)
+        {
+            quantized[i] = 0;
+        }
+        return 1.0f;
+    }
+    const float scale = maxAbs / INT8_LEVELS;
+    const float inverseScale = INT8_LEVELS / maxAbs;
+    for (long i = 0; i < size; i++)
+    {
+        quantized[i] = (int8_t) std::lrint(values[i] * inverseScale);
+    }
+    return scale;
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for QuantizedDense object: quantizes given float weights row by row. exits with an error message if the
+ * bias isn't a vector of one value per row of the weights.
+ * @param w given matrix represents weights
+ * @param bias given matrix (actually a vector) represents bias (kept in float)
+ * @param actType ActivationType for QuantizedDense's Activation
+ */
+QuantizedDense::QuantizedDense(const Matrix &w, const Matrix &bias, ActivationType actType) :
+        rows(w.getRows()), cols(w.getCols()), weights((size_t) w.getRows() * w.getCols()), rowScales(w.getRows()),
+        bias(bias, PackedRows), activation(actType)
+{
+    if (bias.getRows() != rows || bias.getCols() != 1)
+    {
+        std::cerr << "Error: biases vector has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        rowScales[i] = quantizeSymmetric(w.getData() + (long) i * w.getLeadingDim(), cols,
+                                         weights.data() + (long) i * cols);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the layer's number of outputs (rows of the weights matrix)
+ * @return layer's number of outputs
+ */
+int QuantizedDense::getRows() const
+{
+    return this->rows;
+}
+
+/**
+ * getter for the layer's number of inputs (columns of the weights matrix)
+ * @return layer's number of inputs
+ */
+int QuantizedDense::getCols() const
+{
+    return this->cols;
+}
+
+/**
+ * returns the weights matrix the quantized weights stand for (rowScales[i] * weights[i][j])
+ * @return dequantized weights matrix
+ */
+Matrix QuantizedDense::dequantizedWeights() const
+{
+    Matrix matrixToReturn(rows, cols, NoInit);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            matrixToReturn.getData()[(long) i * cols + j] = rowScales[i] * weights[(long) i * cols + j];
+        }
+    }
+    return matrixToReturn;
+}
+
+/**
+ * writes act(w * x + bias) into a caller provided buffer: x is quantized to int8, each output is an int32 dot
+ * product of the int8 row and the int8 input, rescaled by the row's and the input's scales.
+ * @param x input vector of getCols() values
+ * @param out output buffer of getRows() values (must not overlap x)
+ */
+void QuantizedDense::apply(const float *x, float *out) const
+{
+    static const DotInt8Func dotInt8 = selectDotInt8();
+    static thread_local std::vector<int8_t> quantizedInput;
+    if ((int) quantizedInput.size() < cols)
+    {
+        quantizedInput.resize(cols);
+    }
+    const float inputScale = quantizeSymmetric(x, cols, quantizedInput.data());
+    const float *biasValues = this->bias.getData();
+    for (int i = 0; i < rows; i++)
+    {
+        const int32_t dot = dotInt8(weights.data() + (long) i * cols, quantizedInput.data(), cols);
+        out[i] = (float) dot * (rowScales[i] * inputScale) + biasValues[i];
+    }
+    this->activation.applyInPlace(out, rows, 1);
+}
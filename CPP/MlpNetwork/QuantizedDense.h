@@ -0,0 +1,70 @@
+// QuantizedDense.h
+/**
+ * @file QuantizedDense.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief QuantizedDense object class - Dense layer with post-training int8 quantized weights
+ */
+
+#ifndef QUANTIZEDDENSE_H
+#define QUANTIZEDDENSE_H
+
+#include <vector>
+#include <cstdint>
+#include "Matrix.h"
+#include "Activation.h"
+
+/**
+ * class of QuantizedDense object: a Dense layer whose weights are stored as int8 with one symmetric float scale per
+ * row (w[i][j] ~ rowScales[i] * weights[i][j]). inputs are quantized to int8 on the fly with one scale per vector,
+ * every output is an exact int32 dot product rescaled to float, so only the bias and activation run in float.
+ */
+class QuantizedDense
+{
+private:
+    int rows, cols;
+    std::vector<int8_t> weights;
+    std::vector<float> rowScales;
+    Matrix bias;
+    const Activation activation;
+
+public:
+    /**
+     * constructor for QuantizedDense object: quantizes given float weights row by row. exits with an error message
+     * if the bias isn't a vector of one value per row of the weights.
+     * @param w given matrix represents weights
+     * @param bias given matrix (actually a vector) represents bias (kept in float)
+     * @param actType ActivationType for QuantizedDense's Activation
+     */
+    QuantizedDense(const Matrix &w, const Matrix &bias, ActivationType actType);
+
+    /**
+     * getter for the layer's number of outputs (rows of the weights matrix)
+     * @return layer's number of outputs
+     */
+    int getRows() const;
+
+    /**
+     * getter for the layer's number of inputs (columns of the weights matrix)
+     * @return layer's number of inputs
+     */
+    int getCols() const;
+
+    /**
+     * returns the weights matrix the quantized weights stand for (rowScales[i] * weights[i][j]), used to measure the
+     * quantization error.
+     * @return dequantized weights matrix
+     */
+    Matrix dequantizedWeights() const;
+
+    /**
+     * writes act(w * x + bias) into a caller provided buffer: x is quantized to int8, each output is an int32 dot
+     * product of the int8 row and the int8 input, rescaled by the row's and the input's scales.
+     * @param x input vector of getCols() values
+     * @param out output buffer of getRows() values (must not overlap x)
+     */
+    void apply(const float *x, float *out) const;
+};
+
+#endif //QUANTIZEDDENSE_H
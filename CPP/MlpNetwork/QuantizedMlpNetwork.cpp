@@ -0,0 +1,92 @@
+/**
+ * @file QuantizedMlpNetwork.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief QuantizedMlpNetwork object class - MlpNetwork running on int8 quantized weights
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include "QuantizedMlpNetwork.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for QuantizedMlpNetwork object of the default topology: checks the given matrices' dimensions as
+ * MlpNetwork does and quantizes the weights of every layer.
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ */
+QuantizedMlpNetwork::QuantizedMlpNetwork(Matrix weights[], Matrix biases[]) :
+        QuantizedMlpNetwork(defaultLayerSpecs(weights, biases))
+{
+}
+
+/**
+ * constructor for QuantizedMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build())
+ * and quantizes the weights of every planned layer. exits with an error message if the layers' dimensions don't
+ * match.
+ * @param specs network's layers, in order
+ */
+QuantizedMlpNetwork::QuantizedMlpNetwork(std::vector<LayerSpec> specs) : plan(NetworkPlan::build(specs))
+{
+    layers.reserve(specs.size());
+    for (const LayerSpec &spec : specs)
+    {
+        layers.emplace_back(spec.weights, spec.bias, spec.activation);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the network's plan
+ * @return network's plan
+ */
+const NetworkPlan &QuantizedMlpNetwork::getPlan() const
+{
+    return this->plan;
+}
+
+/**
+ * getter for the number of layers the network runs (after folding)
+ * @return number of layers
+ */
+int QuantizedMlpNetwork::getNumLayers() const
+{
+    return (int) this->layers.size();
+}
+
+/**
+ * getter for one of the network's layers (after folding, see MlpNetwork::getLayer())
+ * @param layer layer's index
+ * @return the layer
+ */
+const QuantizedDense &QuantizedMlpNetwork::getLayer(const int layer) const
+{
+    return this->layers[layer];
+}
+
+/**
+ * overloading operator "()" for QuantizedMlpNetwork object: returns a Digit object presents what digit is described
+ * on given matrix presenting an image and at what probability.
+ * @param img given matrix presents an image describing a digit
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit QuantizedMlpNetwork::operator()(const Matrix &img) const
+{
+    static thread_local MlpWorkspace workspace;
+    return (*this)(img, workspace);
+}
+
+/**
+ * overloading operator "()" for QuantizedMlpNetwork object with a caller provided workspace (see MlpNetwork).
+ * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit QuantizedMlpNetwork::operator()(const Matrix &img, MlpWorkspace &workspace) const
+{
+    return classifyWithPlan(plan, layers, img, workspace);
+}
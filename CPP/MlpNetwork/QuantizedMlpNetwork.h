@@ -0,0 +1,80 @@
+// QuantizedMlpNetwork.h
+/**
+ * @file QuantizedMlpNetwork.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief QuantizedMlpNetwork object class - MlpNetwork running on int8 quantized weights
+ */
+
+#ifndef QUANTIZEDMLPNETWORK_H
+#define QUANTIZEDMLPNETWORK_H
+
+#include "MlpNetwork.h"
+#include "QuantizedDense.h"
+
+/**
+ * class of QuantizedMlpNetwork object: any sequence of layers, planned and run as MlpNetwork runs it's layers (see
+ * NetworkPlan.h). every layer is a QuantizedDense built from the float weights when the network is constructed.
+ */
+class QuantizedMlpNetwork : public DigitClassifier
+{
+private:
+    std::vector<QuantizedDense> layers;
+    NetworkPlan plan;
+public:
+    /**
+     * constructor for QuantizedMlpNetwork object of the default topology: checks the given matrices' dimensions as
+     * MlpNetwork does and quantizes the weights of every layer.
+     * @param weights array of MLP_SIZE matrices representing weights
+     * @param biases array of MLP_SIZE matrices representing biases
+     */
+    QuantizedMlpNetwork(Matrix weights[], Matrix biases[]);
+
+    /**
+     * constructor for QuantizedMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build())
+     * and quantizes the weights of every planned layer. exits with an error message if the layers' dimensions don't
+     * match.
+     * @param specs network's layers, in order
+     */
+    explicit QuantizedMlpNetwork(std::vector<LayerSpec> specs);
+
+    /**
+     * getter for the network's plan
+     * @return network's plan
+     */
+    const NetworkPlan &getPlan() const;
+
+    /**
+     * getter for the number of layers the network runs (after folding)
+     * @return number of layers
+     */
+    int getNumLayers() const;
+
+    /**
+     * getter for one of the network's layers (after folding, see MlpNetwork::getLayer())
+     * @param layer layer's index
+     * @return the layer
+     */
+    const QuantizedDense &getLayer(int layer) const;
+
+    /**
+     * overloading operator "()" for QuantizedMlpNetwork object: returns a Digit object presents what digit is described
+     * on given matrix presenting an image and at what probability.
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * overloading operator "()" for QuantizedMlpNetwork object with a caller provided workspace (see MlpNetwork).
+     * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+     * @param workspace workspace to hold the intermediate results
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img, MlpWorkspace &workspace) const;
+};
+
+#endif //QUANTIZEDMLPNETWORK_H
@@ -0,0 +1,253 @@
+/**
+ * @file ResultCache.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief content-addressed caches of classification results: a bounded LRU cache keyed by a 128 bit hash of an
+ * image, and a thread-safe sharded variant of it.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cstring>
+#include <iostream>
+#include "ResultCache.h"
+
+// -------------------------- const definitions -------------------------
+
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME_3 0x165667B19E3779F9ULL
+#define HASH_LANES 4
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * rotates a 64 bit word left
+ * @param word word to rotate
+ * @param bits number of bits, in [1, 63]
+ * @return the rotated word
+ */
+static inline uint64_t rotateLeft(const uint64_t word, const int bits)
+{
+    return word << bits | word >> (64 - bits);
+}
+
+/**
+ * consumes one 64 bit word into a hash lane
+ * @param lane lane's state
+ * @param word word to consume
+ * @return lane's new state
+ */
+static inline uint64_t hashRound(uint64_t lane, const uint64_t word)
+{
+    lane += word * HASH_PRIME_2;
+    return rotateLeft(lane, 31) * HASH_PRIME_1;
+}
+
+/**
+ * final avalanche of a 64 bit word: every input bit flips about half of the output bits
+ * @param word word to mix
+ * @return the mixed word
+ */
+static inline uint64_t avalanche(uint64_t word)
+{
+    word ^= word >> 33;
+    word *= 0xFF51AFD7ED558CCDULL;
+    word ^= word >> 33;
+    word *= 0xC4CEB9FE1A85EC53ULL;
+    word ^= word >> 33;
+    return word;
+}
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * returns the 128 bit hash of an image's values (see ResultCache.h)
+ * @param values image's values
+ * @param size number of values
+ * @return the image's hash
+ */
+ImageHash hashImage(const float *values, const long size)
+{
+    const unsigned char *bytes = (const unsigned char *) values;
+    const size_t length = (size_t) size * sizeof(float);
+    uint64_t lanes[HASH_LANES] = {HASH_PRIME_1 + HASH_PRIME_2, HASH_PRIME_2, 0, 0 - HASH_PRIME_1};
+    size_t offset = 0;
+    for (; offset + HASH_LANES * sizeof(uint64_t) <= length; offset += HASH_LANES * sizeof(uint64_t))
+    {
+        for (int lane = 0; lane < HASH_LANES; lane++)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + offset + lane * sizeof(uint64_t), sizeof(word));
+            lanes[lane] = hashRound(lanes[lane], word);
+        }
+    }
+    for (int lane = 0; offset < length; lane = (lane + 1) % HASH_LANES)
+    {
+        uint64_t word = 0;
+        const size_t count = length - offset < sizeof(word) ? length - offset : sizeof(word);
+        std::memcpy(&word, bytes + offset, count);
+        lanes[lane] = hashRound(lanes[lane], word);
+        offset += count;
+    }
+    const uint64_t mixedLength = (uint64_t) length * HASH_PRIME_3;
+    ImageHash hash;
+    hash.low = avalanche((lanes[0] + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18)) ^
+                         mixedLength);
+    hash.high = avalanche(lanes[2] ^ rotateLeft(lanes[0], 29) ^ rotateLeft(lanes[3], 41) ^ rotateLeft(lanes[1], 53) ^
+                          (mixedLength + hash.low));
+    return hash;
+}
+
+// ------------------------------ LruResultCache -----------------------------
+
+/**
+ * constructor for LruResultCache object
+ * @param capacity maximal number of results held (0 disables the cache: every lookup misses)
+ */
+LruResultCache::LruResultCache(const long capacity) : capacity(capacity), hits(0), misses(0), evictions(0)
+{
+    if (capacity < 0)
+    {
+        std::cerr << "Error: result cache capacity must not be negative" << std::endl;
+        exit(1);
+    }
+    index.reserve((size_t) capacity);
+}
+
+/**
+ * looks up the result of an image: a hit moves it's entry to the front of the use ordered list
+ * @param hash image's hash
+ * @param digit output, the cached result (unchanged on a miss)
+ * @return true on a hit
+ */
+bool LruResultCache::lookup(const ImageHash &hash, Digit &digit)
+{
+    const auto found = index.find(hash);
+    if (found == index.end())
+    {
+        misses++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    digit = found->second->digit;
+    hits++;
+    return true;
+}
+
+/**
+ * caches the result of an image at the front of the use ordered list, evicting the entry at it's back if the cache
+ * is full
+ * @param hash image's hash
+ * @param digit image's result
+ */
+void LruResultCache::insert(const ImageHash &hash, const Digit &digit)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+    const auto found = index.find(hash);
+    if (found != index.end())
+    {
+        found->second->digit = digit;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    if ((long) entries.size() == capacity)
+    {
+        index.erase(entries.back().hash);
+        entries.pop_back();
+        evictions++;
+    }
+    entries.push_front({hash, digit});
+    index.emplace(hash, entries.begin());
+}
+
+/**
+ * getter for the cache's counters
+ * @return the counters
+ */
+CacheStats LruResultCache::getStats() const
+{
+    return {hits, misses, evictions, (long) entries.size()};
+}
+
+// ------------------------------ ShardedResultCache -----------------------------
+
+/**
+ * constructor for ShardedResultCache object: the capacity is split evenly between the shards (the first
+ * capacity % numShards shards hold one more result), so the shards together hold at most capacity results
+ * @param capacity maximal number of results held
+ * @param numShards number of shards, at least 1
+ */
+ShardedResultCache::ShardedResultCache(const long capacity, const int numShards)
+{
+    if (numShards < 1 || capacity < 0)
+    {
+        std::cerr << "Error: result cache needs at least one shard and a non negative capacity" << std::endl;
+        exit(1);
+    }
+    for (int i = 0; i < numShards; i++)
+    {
+        const long shardCapacity = capacity / numShards + (i < capacity % numShards ? 1 : 0);
+        shards.push_back(std::unique_ptr<CacheShard>(new CacheShard(shardCapacity)));
+    }
+}
+
+/**
+ * returns the shard an image belongs to: picked by the hash's high half, as the shard's own hash map buckets by the
+ * low half
+ * @param hash image's hash
+ * @return the image's shard
+ */
+ShardedResultCache::CacheShard &ShardedResultCache::shardOf(const ImageHash &hash) const
+{
+    return *shards[hash.high % shards.size()];
+}
+
+/**
+ * looks up the result of an image (see LruResultCache::lookup())
+ * @param hash image's hash
+ * @param digit output, the cached result (unchanged on a miss)
+ * @return true on a hit
+ */
+bool ShardedResultCache::lookup(const ImageHash &hash, Digit &digit)
+{
+    CacheShard &shard = shardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.lookup(hash, digit);
+}
+
+/**
+ * caches the result of an image (see LruResultCache::insert())
+ * @param hash image's hash
+ * @param digit image's result
+ */
+void ShardedResultCache::insert(const ImageHash &hash, const Digit &digit)
+{
+    CacheShard &shard = shardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.insert(hash, digit);
+}
+
+/**
+ * returns the counters of all the shards summed (every shard is read under it's lock, so the sum is consistent per
+ * shard but not across shards)
+ * @return the counters
+ */
+CacheStats ShardedResultCache::getStats() const
+{
+    CacheStats total = {0, 0, 0, 0};
+    for (const std::unique_ptr<CacheShard> &shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        const CacheStats stats = shard->cache.getStats();
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+        total.entries += stats.entries;
+    }
+    return total;
+}
@@ -0,0 +1,190 @@
+// ResultCache.h
+/**
+ * @file ResultCache.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief content-addressed caches of classification results: a bounded LRU cache keyed by a 128 bit hash of an
+ * image, and a thread-safe sharded variant of it.
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Digit.h"
+
+/**
+ * @struct ImageHash
+ * @brief 128 bit hash of an image's values, the key of a cached result. two different images have the same hash with
+ * a probability of about 2^-128, so a result is looked up by it's hash alone and the image isn't stored.
+ */
+typedef struct ImageHash
+{
+    uint64_t low, high;
+} ImageHash;
+
+/**
+ * overloading operator "==" for ImageHash objects
+ * @param a first hash
+ * @param b second hash
+ * @return true if both halves are equal
+ */
+inline bool operator==(const ImageHash &a, const ImageHash &b)
+{
+    return a.low == b.low && a.high == b.high;
+}
+
+/**
+ * hash functor of ImageHash for unordered containers: the halves are already well mixed, so the low one is used
+ */
+struct ImageHashHasher
+{
+    size_t operator()(const ImageHash &hash) const
+    {
+        return (size_t) hash.low;
+    }
+};
+
+/**
+ * @struct CacheStats
+ * @brief counters of a cache: lookups that found a result (hits) or not (misses), results dropped to make room
+ * (evictions) and results currently cached (entries)
+ */
+typedef struct CacheStats
+{
+    long hits, misses, evictions, entries;
+} CacheStats;
+
+/**
+ * returns the 128 bit hash of an image's values: the bytes are consumed 32 at a time by four independent
+ * multiply-rotate lanes (so the multiplications of the lanes overlap), which are then mixed into two 64 bit halves
+ * that both depend on every lane. the hash is fast, not cryptographic - it separates images, it doesn't resist
+ * crafted collisions.
+ * @param values image's values
+ * @param size number of values
+ * @return the image's hash
+ */
+ImageHash hashImage(const float *values, long size);
+
+/**
+ * class of LruResultCache object: maps image hashes to their Digit, holding at most capacity results and dropping the
+ * least recently used one to make room. the results are kept in a list ordered by use (most recent first) and a hash
+ * map points into it, so a lookup and an insertion are O(1). not thread-safe, see ShardedResultCache.
+ */
+class LruResultCache
+{
+private:
+    /**
+     * @struct CacheEntry
+     * @brief a cached result and it's key
+     */
+    typedef struct CacheEntry
+    {
+        ImageHash hash;
+        Digit digit;
+    } CacheEntry;
+
+    long capacity;
+    std::list<CacheEntry> entries;
+    std::unordered_map<ImageHash, std::list<CacheEntry>::iterator, ImageHashHasher> index;
+    long hits, misses, evictions;
+
+public:
+    /**
+     * constructor for LruResultCache object
+     * @param capacity maximal number of results held (0 disables the cache: every lookup misses)
+     */
+    explicit LruResultCache(long capacity);
+
+    /**
+     * looks up the result of an image, and marks it as the most recently used one if found
+     * @param hash image's hash
+     * @param digit output, the cached result (unchanged on a miss)
+     * @return true on a hit
+     */
+    bool lookup(const ImageHash &hash, Digit &digit);
+
+    /**
+     * caches the result of an image as the most recently used one, evicting the least recently used result if the
+     * cache is full
+     * @param hash image's hash
+     * @param digit image's result
+     */
+    void insert(const ImageHash &hash, const Digit &digit);
+
+    /**
+     * getter for the cache's counters
+     * @return the counters
+     */
+    CacheStats getStats() const;
+};
+
+/**
+ * class of ShardedResultCache object: a thread-safe LRU cache split into shards, each an LruResultCache behind it's
+ * own mutex. an image goes to the shard picked by it's hash, so concurrent lookups of different images rarely wait
+ * for the same lock. every shard evicts on it's own, so the cache as a whole is approximately LRU.
+ */
+class ShardedResultCache
+{
+private:
+    /**
+     * @struct CacheShard
+     * @brief one shard and the mutex guarding it
+     */
+    typedef struct CacheShard
+    {
+        std::mutex mutex;
+        LruResultCache cache;
+
+        explicit CacheShard(const long capacity) : cache(capacity)
+        {
+        }
+    } CacheShard;
+
+    std::vector<std::unique_ptr<CacheShard>> shards;
+
+    /**
+     * returns the shard an image belongs to
+     * @param hash image's hash
+     * @return the image's shard
+     */
+    CacheShard &shardOf(const ImageHash &hash) const;
+
+public:
+    /**
+     * constructor for ShardedResultCache object: the capacity is split evenly between the shards (the first
+     * capacity % numShards shards hold one more result), so the shards together hold at most capacity results
+     * @param capacity maximal number of results held
+     * @param numShards number of shards, at least 1
+     */
+    ShardedResultCache(long capacity, int numShards);
+
+    /**
+     * looks up the result of an image (see LruResultCache::lookup())
+     * @param hash image's hash
+     * @param digit output, the cached result (unchanged on a miss)
+     * @return true on a hit
+     */
+    bool lookup(const ImageHash &hash, Digit &digit);
+
+    /**
+     * caches the result of an image (see LruResultCache::insert())
+     * @param hash image's hash
+     * @param digit image's result
+     */
+    void insert(const ImageHash &hash, const Digit &digit);
+
+    /**
+     * returns the counters of all the shards summed
+     * @return the counters
+     */
+    CacheStats getStats() const;
+};
+
+#endif //RESULTCACHE_H
@@ -0,0 +1,695 @@
+/**
+ * @file SimdKernels.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief vectorized element-wise kernels with runtime (cpuid based) instruction set dispatch.
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "SimdKernels.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// -------------------------- const definitions -------------------------
+
+/**
+ * constants of the exp approximation (cephes' expf): exp(x) = 2^n * exp(r), where n = round(x / ln2) and
+ * r = x - n * ln2 is in [-ln2 / 2, ln2 / 2]. ln2 is split into EXP_LN2_HI + EXP_LN2_LO so r is computed without
+ * cancellation, and exp(r) is 1 + r + r^2 * P(r) with a degree 5 minimax polynomial P.
+ */
+#define EXP_MIN (-87.33654475f)
+#define EXP_MAX 88.37626266f
+#define EXP_LOG2E 1.44269504f
+#define EXP_LN2_HI 0.693359375f
+#define EXP_LN2_LO (-2.12194440e-4f)
+#define EXP_P0 1.9875691500e-4f
+#define EXP_P1 1.3981999507e-3f
+#define EXP_P2 8.3334519073e-3f
+#define EXP_P3 4.1665795894e-2f
+#define EXP_P4 1.6666665459e-1f
+#define EXP_P5 5.0000001201e-1f
+
+// ------------------------------ scalar kernels -----------------------------
+
+/**
+ * out = a + b, element by element
+ */
+static void addScalar(const float *a, const float *b, float *out, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+/**
+ * out = scalar * a, element by element
+ */
+static void scaleScalar(const float *a, const float scalar, float *out, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = scalar * a[i];
+    }
+}
+
+/**
+ * y = alpha * x + y, element by element
+ */
+static void axpyScalar(const float alpha, const float *x, float *y, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+/**
+ * out = max(a, 0), element by element (a NaN gives 0, as the SIMD max instructions do)
+ */
+static void reluScalar(const float *a, float *out, const long n)
+{
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = a[i] > 0 ? a[i] : 0;
+    }
+}
+
+/**
+ * returns the largest element of a (-FLT_MAX for an empty array)
+ */
+static float maxScalar(const float *a, const long n)
+{
+    float result = -FLT_MAX;
+    for (long i = 0; i < n; i++)
+    {
+        result = a[i] > result ? a[i] : result;
+    }
+    return result;
+}
+
+/**
+ * returns the sum of the elements of a
+ */
+static float sumScalar(const float *a, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += a[i];
+    }
+    return result;
+}
+
+/**
+ * returns the dot product of a and b
+ */
+static float dotScalar(const float *a, const float *b, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+/**
+ * polynomial approximation of exp(x) (see EXP_MIN...EXP_P5)
+ */
+static float expApprox(float x)
+{
+    if (x < EXP_MIN)
+    {
+        return 0;
+    }
+    x = x > EXP_MAX ? EXP_MAX : x;
+    const float n = std::floor(x * EXP_LOG2E + 0.5f);
+    const float r = x - n * EXP_LN2_HI - n * EXP_LN2_LO;
+    float p = EXP_P0;
+    p = p * r + EXP_P1;
+    p = p * r + EXP_P2;
+    p = p * r + EXP_P3;
+    p = p * r + EXP_P4;
+    p = p * r + EXP_P5;
+    const int32_t bits = ((int32_t) n + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return (p * r * r + r + 1) * scale;
+}
+
+/**
+ * out = exp(a - shift), element by element, returns the sum of out
+ */
+static float expSumScalar(const float *a, const float shift, float *out, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        out[i] = expApprox(a[i] - shift);
+        result += out[i];
+    }
+    return result;
+}
+
+#ifdef SIMD_X86_DISPATCH
+
+// ------------------------------ SSE4 kernels -----------------------------
+
+__attribute__((target("sse4.1")))
+static void addSse4(const float *a, const float *b, float *out, const long n)
+{
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    addScalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void scaleSse4(const float *a, const float scalar, float *out, const long n)
+{
+    const __m128 s = _mm_set1_ps(scalar);
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_mul_ps(s, _mm_loadu_ps(a + i)));
+    }
+    scaleScalar(a + i, scalar, out + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void axpySse4(const float alpha, const float *x, float *y, const long n)
+{
+    const __m128 s = _mm_set1_ps(alpha);
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(s, _mm_loadu_ps(x + i))));
+    }
+    axpyScalar(alpha, x + i, y + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static void reluSse4(const float *a, float *out, const long n)
+{
+    const __m128 zero = _mm_setzero_ps();
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_max_ps(_mm_loadu_ps(a + i), zero));
+    }
+    reluScalar(a + i, out + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static float maxSse4(const float *a, const long n)
+{
+    __m128 acc = _mm_set1_ps(-FLT_MAX);
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm_max_ps(acc, _mm_loadu_ps(a + i));
+    }
+    acc = _mm_max_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_max_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    const float tail = maxScalar(a + i, n - i);
+    const float head = _mm_cvtss_f32(acc);
+    return head > tail ? head : tail;
+}
+
+__attribute__((target("sse4.1")))
+static float sumSse4(const float *a, const long n)
+{
+    __m128 acc = _mm_setzero_ps();
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(a + i));
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    return _mm_cvtss_f32(acc) + sumScalar(a + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static float dotSse4(const float *a, const float *b, const long n)
+{
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    return _mm_cvtss_f32(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+/**
+ * exp approximation of 4 floats (see expApprox()), NaN lanes are passed through like expApprox() does
+ */
+__attribute__((target("sse4.1")))
+static __m128 expSse4(const __m128 x)
+{
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(EXP_MIN)), _mm_set1_ps(EXP_MAX));
+    const __m128 n = _mm_floor_ps(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(EXP_LOG2E)), _mm_set1_ps(0.5f)));
+    __m128 r = _mm_sub_ps(clamped, _mm_mul_ps(n, _mm_set1_ps(EXP_LN2_HI)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(EXP_LN2_LO)));
+    __m128 p = _mm_set1_ps(EXP_P0);
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P1));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P2));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P3));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P4));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(EXP_P5));
+    p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r), r), r), _mm_set1_ps(1.0f));
+    const __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+    const __m128 inRange = _mm_cmpge_ps(x, _mm_set1_ps(EXP_MIN));
+    return _mm_blendv_ps(_mm_and_ps(_mm_mul_ps(p, _mm_castsi128_ps(bits)), inRange), x, _mm_cmpunord_ps(x, x));
+}
+
+__attribute__((target("sse4.1")))
+static float expSumSse4(const float *a, const float shift, float *out, const long n)
+{
+    const __m128 s = _mm_set1_ps(shift);
+    __m128 acc = _mm_setzero_ps();
+    long i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 e = expSse4(_mm_sub_ps(_mm_loadu_ps(a + i), s));
+        _mm_storeu_ps(out + i, e);
+        acc = _mm_add_ps(acc, e);
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    return _mm_cvtss_f32(acc) + expSumScalar(a + i, shift, out + i, n - i);
+}
+
+// ------------------------------ AVX2 kernels -----------------------------
+
+__attribute__((target("avx2")))
+static void addAvx2(const float *a, const float *b, float *out, const long n)
+{
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    addSse4(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void scaleAvx2(const float *a, const float scalar, float *out, const long n)
+{
+    const __m256 s = _mm256_set1_ps(scalar);
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(s, _mm256_loadu_ps(a + i)));
+    }
+    scaleSse4(a + i, scalar, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void axpyAvx2(const float alpha, const float *x, float *y, const long n)
+{
+    const __m256 s = _mm256_set1_ps(alpha);
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(s, _mm256_loadu_ps(x + i))));
+    }
+    axpySse4(alpha, x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void reluAvx2(const float *a, float *out, const long n)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_max_ps(_mm256_loadu_ps(a + i), zero));
+    }
+    reluSse4(a + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static float maxAvx2(const float *a, const long n)
+{
+    __m256 acc = _mm256_set1_ps(-FLT_MAX);
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc = _mm256_max_ps(acc, _mm256_loadu_ps(a + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    const float head = maxScalar(lanes, 8);
+    const float tail = maxSse4(a + i, n - i);
+    return head > tail ? head : tail;
+}
+
+__attribute__((target("avx2")))
+static float sumAvx2(const float *a, const long n)
+{
+    __m256 acc = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(a + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return sumScalar(lanes, 8) + sumSse4(a + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static float dotAvx2(const float *a, const float *b, const long n)
+{
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(acc0, acc1));
+    return sumScalar(lanes, 8) + dotSse4(a + i, b + i, n - i);
+}
+
+/**
+ * exp approximation of 8 floats (see expApprox()), NaN lanes are passed through like expApprox() does
+ */
+__attribute__((target("avx2")))
+static __m256 expAvx2(const __m256 x)
+{
+    const __m256 clamped = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_MIN)), _mm256_set1_ps(EXP_MAX));
+    const __m256 n = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(clamped, _mm256_set1_ps(EXP_LOG2E)),
+                                                   _mm256_set1_ps(0.5f)));
+    __m256 r = _mm256_sub_ps(clamped, _mm256_mul_ps(n, _mm256_set1_ps(EXP_LN2_HI)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(n, _mm256_set1_ps(EXP_LN2_LO)));
+    __m256 p = _mm256_set1_ps(EXP_P0);
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(EXP_P1));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(EXP_P2));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(EXP_P3));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(EXP_P4));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(EXP_P5));
+    p = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, r), r), r), _mm256_set1_ps(1.0f));
+    const __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23);
+    const __m256 inRange = _mm256_cmp_ps(x, _mm256_set1_ps(EXP_MIN), _CMP_GE_OQ);
+    return _mm256_blendv_ps(_mm256_and_ps(_mm256_mul_ps(p, _mm256_castsi256_ps(bits)), inRange), x,
+                            _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+}
+
+__attribute__((target("avx2")))
+static float expSumAvx2(const float *a, const float shift, float *out, const long n)
+{
+    const __m256 s = _mm256_set1_ps(shift);
+    __m256 acc = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 e = expAvx2(_mm256_sub_ps(_mm256_loadu_ps(a + i), s));
+        _mm256_storeu_ps(out + i, e);
+        acc = _mm256_add_ps(acc, e);
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return sumScalar(lanes, 8) + expSumSse4(a + i, shift, out + i, n - i);
+}
+
+// ------------------------------ AVX-512 kernels -----------------------------
+
+__attribute__((target("avx512f")))
+static void addAvx512(const float *a, const float *b, float *out, const long n)
+{
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(out + i, mask,
+                              _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void scaleAvx512(const float *a, const float scalar, float *out, const long n)
+{
+    const __m512 s = _mm512_set1_ps(scalar);
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(s, _mm512_loadu_ps(a + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(out + i, mask, _mm512_mul_ps(s, _mm512_maskz_loadu_ps(mask, a + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void axpyAvx512(const float alpha, const float *x, float *y, const long n)
+{
+    const __m512 s = _mm512_set1_ps(alpha);
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(s, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        const __m512 xValues = _mm512_maskz_loadu_ps(mask, x + i);
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_fmadd_ps(s, xValues, _mm512_maskz_loadu_ps(mask, y + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void reluAvx512(const float *a, float *out, const long n)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(out + i, _mm512_maskz_max_ps(0xFFFF, _mm512_loadu_ps(a + i), zero));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(out + i, mask, _mm512_maskz_max_ps(mask, _mm512_maskz_loadu_ps(mask, a + i), zero));
+    }
+}
+
+__attribute__((target("avx512f")))
+static float maxAvx512(const float *a, const long n)
+{
+    __m512 acc = _mm512_set1_ps(-FLT_MAX);
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = _mm512_mask_max_ps(acc, 0xFFFF, acc, _mm512_loadu_ps(a + i));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        acc = _mm512_mask_max_ps(acc, mask, acc, _mm512_maskz_loadu_ps(mask, a + i));
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, acc);
+    return maxScalar(lanes, 16);
+}
+
+__attribute__((target("avx512f")))
+static float sumAvx512(const float *a, const long n)
+{
+    __m512 acc = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc = _mm512_add_ps(acc, _mm512_loadu_ps(a + i));
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        acc = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(mask, a + i));
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, acc);
+    return sumScalar(lanes, 16);
+}
+
+__attribute__((target("avx512f")))
+static float dotAvx512(const float *a, const float *b, const long n)
+{
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i < n; i += 16)
+    {
+        const __mmask16 mask = n - i >= 16 ? (__mmask16) 0xFFFF : (__mmask16) ((1u << (n - i)) - 1);
+        acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), acc0);
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, _mm512_add_ps(acc0, acc1));
+    return sumScalar(lanes, 16);
+}
+
+/**
+ * exp approximation of 16 floats (see expApprox()), the power of 2 is applied by vscalefps and NaN lanes are
+ * passed through like expApprox() does
+ */
+__attribute__((target("avx512f")))
+static __m512 expAvx512(const __m512 x)
+{
+    const __m512 clamped = _mm512_maskz_min_ps(0xFFFF, _mm512_maskz_max_ps(0xFFFF, x, _mm512_set1_ps(EXP_MIN)),
+                                               _mm512_set1_ps(EXP_MAX));
+    const __m512 n = _mm512_maskz_roundscale_ps(0xFFFF, _mm512_fmadd_ps(clamped, _mm512_set1_ps(EXP_LOG2E),
+                                                                        _mm512_set1_ps(0.5f)),
+                                                _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_LN2_HI), clamped);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(EXP_LN2_LO), r);
+    __m512 p = _mm512_set1_ps(EXP_P0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P2));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P3));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P4));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_P5));
+    p = _mm512_fmadd_ps(_mm512_mul_ps(p, r), r, _mm512_add_ps(r, _mm512_set1_ps(1.0f)));
+    const __mmask16 inRange = _mm512_cmp_ps_mask(x, _mm512_set1_ps(EXP_MIN), _CMP_GE_OQ);
+    return _mm512_mask_mov_ps(_mm512_maskz_scalef_ps(inRange, p, n), _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), x);
+}
+
+__attribute__((target("avx512f")))
+static float expSumAvx512(const float *a, const float shift, float *out, const long n)
+{
+    const __m512 s = _mm512_set1_ps(shift);
+    __m512 acc = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512 e = expAvx512(_mm512_sub_ps(_mm512_loadu_ps(a + i), s));
+        _mm512_storeu_ps(out + i, e);
+        acc = _mm512_add_ps(acc, e);
+    }
+    if (i < n)
+    {
+        const __mmask16 mask = (__mmask16) ((1u << (n - i)) - 1);
+        const __m512 e = expAvx512(_mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i), s));
+        _mm512_mask_storeu_ps(out + i, mask, e);
+        acc = _mm512_mask_add_ps(acc, mask, acc, e);
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, acc);
+    return sumScalar(lanes, 16);
+}
+
+#endif
+
+// ------------------------------ kernel tables -----------------------------
+
+static const SimdKernelTable scalarTable = {ScalarIsa, addScalar, scaleScalar, axpyScalar, reluScalar, maxScalar,
+                                            sumScalar, dotScalar, expSumScalar};
+
+#ifdef SIMD_X86_DISPATCH
+static const SimdKernelTable sse4Table = {Sse4Isa, addSse4, scaleSse4, axpySse4, reluSse4, maxSse4, sumSse4, dotSse4,
+                                          expSumSse4};
+static const SimdKernelTable avx2Table = {Avx2Isa, addAvx2, scaleAvx2, axpyAvx2, reluAvx2, maxAvx2, sumAvx2, dotAvx2,
+                                          expSumAvx2};
+static const SimdKernelTable avx512Table = {Avx512Isa, addAvx512, scaleAvx512, axpyAvx512, reluAvx512, maxAvx512,
+                                            sumAvx512, dotAvx512, expSumAvx512};
+#endif
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * returns the kernel table for a given instruction set, or the scalar table when the host cpu does not support it.
+ * @param isa requested instruction set
+ * @return kernel table compiled for isa
+ */
+const SimdKernelTable &simdKernelsFor(const SimdIsa isa)
+{
+#ifdef SIMD_X86_DISPATCH
+    __builtin_cpu_init();
+    if (isa == Avx512Isa && __builtin_cpu_supports("avx512f"))
+    {
+        return avx512Table;
+    }
+    if (isa == Avx2Isa && __builtin_cpu_supports("avx2"))
+    {
+        return avx2Table;
+    }
+    if (isa == Sse4Isa && __builtin_cpu_supports("sse4.1"))
+    {
+        return sse4Table;
+    }
+#else
+    (void) isa;
+#endif
+    return scalarTable;
+}
+
+/**
+ * returns the kernel table for the widest instruction set supported by the host cpu. the cpu is queried once, on
+ * the first call.
+ * @return kernel table to use for element-wise operations
+ */
+const SimdKernelTable &simdKernels()
+{
+    static const SimdKernelTable &table = []() -> const SimdKernelTable &
+    {
+        const SimdIsa preferred[] = {Avx512Isa, Avx2Isa, Sse4Isa};
+        for (SimdIsa isa : preferred)
+        {
+            const SimdKernelTable &candidate = simdKernelsFor(isa);
+            if (candidate.isa == isa)
+            {
+                return candidate;
+            }
+        }
+        return scalarTable;
+    }();
+    return table;
+}
+
+/**
+ * returns a printable name of the given instruction set
+ * @param isa instruction set
+ * @return instruction set's name
+ */
+const char *simdIsaName(const SimdIsa isa)
+{
+    switch (isa)
+    {
+        case Sse4Isa:
+            return "sse4";
+        case Avx2Isa:
+            return "avx2";
+        case Avx512Isa:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
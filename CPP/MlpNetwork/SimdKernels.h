@@ -0,0 +1,69 @@
+// SimdKernels.h
+/**
+ * @file SimdKernels.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief vectorized element-wise kernels with runtime (cpuid based) instruction set dispatch.
+ */
+
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+/**
+ * @enum SimdIsa
+ * @brief instruction set the element-wise kernels were compiled for.
+ */
+enum SimdIsa
+{
+    ScalarIsa,
+    Sse4Isa,
+    Avx2Isa,
+    Avx512Isa
+};
+
+/**
+ * @struct SimdKernelTable
+ * @brief table of element-wise kernels for one instruction set. all kernels accept unaligned pointers and any length,
+ * and "out" may be the same buffer as an input.
+ * expSum - writes out[i] = exp(a[i] - shift) and returns the sum of the written values. exp is a polynomial
+ * approximation (see SimdKernels.cpp), the same polynomial for every instruction set: it's relative error is below
+ * 1.2e-7 (1 ulp of the correctly rounded result) for arguments in [-87.33, 88.37]. smaller arguments give 0 and
+ * larger ones give exp(88.37) ~ 2.4e38, so it never returns inf.
+ */
+typedef struct SimdKernelTable
+{
+    SimdIsa isa;
+    void (*add)(const float *a, const float *b, float *out, long n);
+    void (*scale)(const float *a, float scalar, float *out, long n);
+    void (*axpy)(float alpha, const float *x, float *y, long n);
+    void (*relu)(const float *a, float *out, long n);
+    float (*max)(const float *a, long n);
+    float (*sum)(const float *a, long n);
+    float (*dot)(const float *a, const float *b, long n);
+    float (*expSum)(const float *a, float shift, float *out, long n);
+} SimdKernelTable;
+
+/**
+ * returns the kernel table for the widest instruction set supported by the host cpu. the cpu is queried once, on
+ * the first call.
+ * @return kernel table to use for element-wise operations
+ */
+const SimdKernelTable &simdKernels();
+
+/**
+ * returns the kernel table for a given instruction set, or the scalar table when the host cpu does not support it.
+ * used to compare the different versions against each other.
+ * @param isa requested instruction set
+ * @return kernel table compiled for isa
+ */
+const SimdKernelTable &simdKernelsFor(SimdIsa isa);
+
+/**
+ * returns a printable name of the given instruction set
+ * @param isa instruction set
+ * @return instruction set's name
+ */
+const char *simdIsaName(SimdIsa isa);
+
+#endif //SIMDKERNELS_H
@@ -0,0 +1,313 @@
+/**
+ * @file SparseDense.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief SparseDense object class - Dense layer with magnitude pruned weights stored in CSR format
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "SparseDense.h"
+#include "SimdKernels.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SPARSE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * sparse dot product compiled for the baseline ISA of the build: sum of values[i] * x[indices[i]]
+ */
+static float sparseDotGeneric(const float *values, const int *indices, const float *x, const long n)
+{
+    float result = 0;
+    for (long i = 0; i < n; i++)
+    {
+        result += values[i] * x[indices[i]];
+    }
+    return result;
+}
+
+#ifdef SPARSE_X86_DISPATCH
+
+/**
+ * sparse dot product for AVX2: the inputs of 8 non-zeros are loaded by one gather.
+ */
+__attribute__((target("avx2")))
+static float sparseDotAvx2(const float *values, const int *indices, const float *x, const long n)
+{
+    const __m256 allLanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    __m256 acc = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i index = _mm256_loadu_si256((const __m256i *) (indices + i));
+        const __m256 gathered = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, index, allLanes, 4);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(values + i), gathered));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    float result = 0;
+    for (int lane = 0; lane < 8; lane++)
+    {
+        result += lanes[lane];
+    }
+    return result + sparseDotGeneric(values + i, indices + i, x, n - i);
+}
+
+/**
+ * sparse dot product for AVX-512: the inputs of 16 non-zeros are loaded by one gather, the tail by a masked gather.
+ */
+__attribute__((target("avx512f")))
+static float sparseDotAvx512(const float *values, const int *indices, const float *x, const long n)
+{
+    __m512 acc = _mm512_setzero_ps();
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512i index = _mm512_loadu_si512((const void *) (indices + i));
+        const __m512 gathered = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, index, x, 4);
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(values + i), gathered, acc);
+    }
+    if (i < n)
+    {
+        const __mmask16 tail = (__mmask16) ((1u << (n - i)) - 1);
+        const __m512i index = _mm512_maskz_loadu_epi32(tail, indices + i);
+        const __m512 gathered = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), tail, index, x, 4);
+        acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, values + i), gathered, acc);
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, acc);
+    float result = 0;
+    for (int lane = 0; lane < 16; lane++)
+    {
+        result += lanes[lane];
+    }
+    return result;
+}
+
+#endif
+
+/**
+ * pointer type of the sparse dot product versions
+ */
+typedef float (*SparseDotFunc)(const float *values, const int *indices, const float *x, long n);
+
+/**
+ * picks the widest sparse dot product the host cpu supports
+ * @return pointer to the chosen dot product
+ */
+static SparseDotFunc selectSparseDot()
+{
+#ifdef SPARSE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return sparseDotAvx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return sparseDotAvx2;
+    }
+#endif
+    return sparseDotGeneric;
+}
+
+// ------------------------------ functions -----------------------------
+
+/**
+ * zeroes every weight whose magnitude is below a given threshold
+ * @param w weights matrix to prune in place
+ * @param threshold smallest magnitude kept
+ * @return number of weights that are zero after pruning
+ */
+long pruneWeights(Matrix &w, const float threshold)
+{
+    long zeros = 0;
+    for (int i = 0; i < w.getRows(); i++)
+    {
+        float *row = w.getData() + (long) i * w.getLeadingDim();
+        for (int j = 0; j < w.getCols(); j++)
+        {
+            if (std::fabs(row[j]) < threshold)
+            {
+                row[j] = 0;
+            }
+            zeros += row[j] == 0;
+        }
+    }
+    return zeros;
+}
+
+/**
+ * returns the magnitude threshold that prunes a given fraction of a weights matrix: pruneWeights() with it zeroes
+ * that fraction of the weights (less when several weights have the threshold's magnitude, as these are kept).
+ * @param w weights matrix
+ * @param sparsity fraction of the weights to prune, in [0, 1]
+ * @return magnitude threshold
+ */
+float sparsityThreshold(const Matrix &w, const float sparsity)
+{
+    std::vector<float> magnitudes;
+    magnitudes.reserve((size_t) w.getRows() * w.getCols());
+    for (int i = 0; i < w.getRows(); i++)
+    {
+        const float *row = w.getData() + (long) i * w.getLeadingDim();
+        for (int j = 0; j < w.getCols(); j++)
+        {
+            magnitudes.push_back(std::fabs(row[j]));
+        }
+    }
+    const size_t pruned = (size_t) std::lround(std::fmin(std::fmax(sparsity, 0.0f), 1.0f) * magnitudes.size());
+    if (pruned >= magnitudes.size())
+    {
+        return INFINITY;
+    }
+    std::nth_element(magnitudes.begin(), magnitudes.begin() + (long) pruned, magnitudes.end());
+    return magnitudes[pruned];
+}
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for SparseDense object: keeps the weights whose magnitude is at least threshold (with the default
+ * threshold of 0 every non-zero weight is kept, so a matrix pruned beforehand is stored exactly).
+ * @param w given matrix represents weights
+ * @param bias given matrix (actually a vector) represents bias
+ * @param actType ActivationType for SparseDense's Activation
+ * @param threshold smallest magnitude of a kept weight
+ */
+SparseDense::SparseDense(const Matrix &w, const Matrix &bias, ActivationType actType, const float threshold) :
+        rows(w.getRows()), cols(w.getCols()), rowOffsets(w.getRows() + 1), bias(bias, PackedRows),
+        activation(actType)
+{
+    rowOffsets[0] = 0;
+    for (int i = 0; i < rows; i++)
+    {
+        const float *row = w.getData() + (long) i * w.getLeadingDim();
+        for (int j = 0; j < cols; j++)
+        {
+            if (row[j] != 0 && std::fabs(row[j]) >= threshold)
+            {
+                values.push_back(row[j]);
+                colIndices.push_back(j);
+            }
+        }
+        rowOffsets[i + 1] = (int) values.size();
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the layer's number of outputs (rows of the weights matrix)
+ * @return layer's number of outputs
+ */
+int SparseDense::getRows() const
+{
+    return this->rows;
+}
+
+/**
+ * getter for the layer's number of inputs (columns of the weights matrix)
+ * @return layer's number of inputs
+ */
+int SparseDense::getCols() const
+{
+    return this->cols;
+}
+
+/**
+ * getter for the number of weights kept
+ * @return number of non-zero weights
+ */
+long SparseDense::getNonZeros() const
+{
+    return (long) this->values.size();
+}
+
+/**
+ * returns the fraction of the weights matrix that was pruned
+ * @return sparsity, in [0, 1]
+ */
+float SparseDense::getSparsity() const
+{
+    const long size = (long) rows * cols;
+    return size == 0 ? 0 : 1 - (float) getNonZeros() / (float) size;
+}
+
+/**
+ * returns the (pruned) weights as a dense matrix
+ * @return weights matrix with zeros in place of the pruned weights
+ */
+Matrix SparseDense::toDense() const
+{
+    Matrix matrixToReturn(rows, cols);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++)
+        {
+            matrixToReturn.getData()[(long) i * cols + colIndices[k]] = values[k];
+        }
+    }
+    return matrixToReturn;
+}
+
+/**
+ * writes act(w * x + bias) into a caller provided buffer: every output is a dot product of the row's non-zeros
+ * with the input values they gather.
+ * @param x input vector of getCols() values
+ * @param out output buffer of getRows() values (must not overlap x)
+ */
+void SparseDense::apply(const float *x, float *out) const
+{
+    static const SparseDotFunc sparseDot = selectSparseDot();
+    const float *biasValues = this->bias.getData();
+    for (int i = 0; i < rows; i++)
+    {
+        const int first = rowOffsets[i];
+        out[i] = sparseDot(values.data() + first, colIndices.data() + first, x, rowOffsets[i + 1] - first) +
+                 biasValues[i];
+    }
+    this->activation.applyInPlace(out, rows, 1);
+}
+
+/**
+ * overloading operator "()" for SparseDense object: returns act(w * m + bias) for a batch of input vectors (each
+ * column of m is a vector). the sparse times dense product adds every non-zero w[i][k] times row k of m into row
+ * i of the result, so every non-zero is read once per batch and the batch's rows are streamed contiguously.
+ * @param m given matrix of getCols() rows
+ * @return new matrix of getRows() rows, a column per input vector
+ */
+Matrix SparseDense::operator()(const Matrix &m) const
+{
+    if (m.getRows() != cols)
+    {
+        std::cerr << "Error: SparseDense input matrix has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    const int batchSize = m.getCols();
+    Matrix matrixToReturn(rows, batchSize, NoInit);
+    if (batchSize == 1 && m.getLeadingDim() == 1)
+    {
+        apply(m.getData(), matrixToReturn.getData());
+        return matrixToReturn;
+    }
+    const SimdKernelTable &kernels = simdKernels();
+    for (int i = 0; i < rows; i++)
+    {
+        float *row = matrixToReturn.getData() + (long) i * batchSize;
+        std::fill(row, row + batchSize, this->bias[i]);
+        for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++)
+        {
+            kernels.axpy(values[k], m.getData() + (long) colIndices[k] * m.getLeadingDim(), row, batchSize);
+        }
+    }
+    return this->activation(std::move(matrixToReturn));
+}
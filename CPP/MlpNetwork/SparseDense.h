@@ -0,0 +1,109 @@
+// SparseDense.h
+/**
+ * @file SparseDense.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief SparseDense object class - Dense layer with magnitude pruned weights stored in CSR format
+ */
+
+#ifndef SPARSEDENSE_H
+#define SPARSEDENSE_H
+
+#include <vector>
+#include "Matrix.h"
+#include "Activation.h"
+
+/**
+ * zeroes every weight whose magnitude is below a given threshold
+ * @param w weights matrix to prune in place
+ * @param threshold smallest magnitude kept
+ * @return number of weights that are zero after pruning
+ */
+long pruneWeights(Matrix &w, float threshold);
+
+/**
+ * returns the magnitude threshold that prunes a given fraction of a weights matrix: pruneWeights() with it zeroes
+ * that fraction of the weights (less when several weights have the threshold's magnitude, as these are kept).
+ * @param w weights matrix
+ * @param sparsity fraction of the weights to prune, in [0, 1]
+ * @return magnitude threshold
+ */
+float sparsityThreshold(const Matrix &w, float sparsity);
+
+/**
+ * class of SparseDense object: a Dense layer that keeps only the non-zero weights, in compressed sparse row (CSR)
+ * format - the non-zeros of row i are values[rowOffsets[i]] to values[rowOffsets[i + 1] - 1], in column order, and
+ * colIndices holds the column of every non-zero. the work of a product is proportional to the number of non-zeros,
+ * so a layer pruned to 90% sparsity does about a tenth of the multiplications of a Dense.
+ */
+class SparseDense
+{
+private:
+    int rows, cols;
+    std::vector<int> rowOffsets;
+    std::vector<int> colIndices;
+    std::vector<float> values;
+    Matrix bias;
+    const Activation activation;
+
+public:
+    /**
+     * constructor for SparseDense object: keeps the weights whose magnitude is at least threshold (with the default
+     * threshold of 0 every non-zero weight is kept, so a matrix pruned beforehand is stored exactly).
+     * @param w given matrix represents weights
+     * @param bias given matrix (actually a vector) represents bias
+     * @param actType ActivationType for SparseDense's Activation
+     * @param threshold smallest magnitude of a kept weight
+     */
+    SparseDense(const Matrix &w, const Matrix &bias, ActivationType actType, float threshold = 0);
+
+    /**
+     * getter for the layer's number of outputs (rows of the weights matrix)
+     * @return layer's number of outputs
+     */
+    int getRows() const;
+
+    /**
+     * getter for the layer's number of inputs (columns of the weights matrix)
+     * @return layer's number of inputs
+     */
+    int getCols() const;
+
+    /**
+     * getter for the number of weights kept
+     * @return number of non-zero weights
+     */
+    long getNonZeros() const;
+
+    /**
+     * returns the fraction of the weights matrix that was pruned
+     * @return sparsity, in [0, 1]
+     */
+    float getSparsity() const;
+
+    /**
+     * returns the (pruned) weights as a dense matrix
+     * @return weights matrix with zeros in place of the pruned weights
+     */
+    Matrix toDense() const;
+
+    /**
+     * writes act(w * x + bias) into a caller provided buffer: every output is a dot product of the row's non-zeros
+     * with the input values they gather.
+     * @param x input vector of getCols() values
+     * @param out output buffer of getRows() values (must not overlap x)
+     */
+    void apply(const float *x, float *out) const;
+
+    /**
+     * overloading operator "()" for SparseDense object: returns act(w * m + bias) for a batch of input vectors (each
+     * column of m is a vector). the sparse times dense product adds every non-zero w[i][k] times row k of m into row
+     * i of the result, so every non-zero is read once per batch and the batch's rows are streamed contiguously.
+     * @param m given matrix of getCols() rows
+     * @return new matrix of getRows() rows, a column per input vector
+     */
+    Matrix operator()(const Matrix &m) const;
+};
+
+#endif //SPARSEDENSE_H
@@ -0,0 +1,111 @@
+/**
+ * @file SparseMlpNetwork.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief SparseMlpNetwork object class - MlpNetwork running on magnitude pruned weights
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include "SparseMlpNetwork.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for SparseMlpNetwork object of the default topology: checks the given matrices' dimensions as
+ * MlpNetwork does and prunes the weights of every layer.
+ * @param weights array of MLP_SIZE matrices representing weights
+ * @param biases array of MLP_SIZE matrices representing biases
+ * @param thresholds array of MLP_SIZE pruning thresholds, one per layer (see SparseDense)
+ */
+SparseMlpNetwork::SparseMlpNetwork(Matrix weights[], Matrix biases[], const float thresholds[]) :
+        SparseMlpNetwork(defaultLayerSpecs(weights, biases), std::vector<float>(thresholds, thresholds + MLP_SIZE))
+{
+}
+
+/**
+ * constructor for SparseMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build()) and
+ * prunes the weights of every planned layer. exits with an error message if the layers' dimensions don't match,
+ * or if there isn't one threshold per planned layer.
+ * @param specs network's layers, in order
+ * @param thresholds pruning thresholds, one per layer the plan runs (after folding, see SparseDense)
+ */
+SparseMlpNetwork::SparseMlpNetwork(std::vector<LayerSpec> specs, const std::vector<float> &thresholds) :
+        plan(NetworkPlan::build(specs))
+{
+    if (thresholds.size() != specs.size())
+    {
+        std::cerr << "Error: number of pruning thresholds doesn't match the number of layers" << std::endl;
+        exit(1);
+    }
+    layers.reserve(specs.size());
+    for (size_t i = 0; i < specs.size(); i++)
+    {
+        layers.emplace_back(specs[i].weights, specs[i].bias, specs[i].activation, thresholds[i]);
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the network's plan
+ * @return network's plan
+ */
+const NetworkPlan &SparseMlpNetwork::getPlan() const
+{
+    return this->plan;
+}
+
+/**
+ * getter for the number of layers the network runs (after folding)
+ * @return number of layers
+ */
+int SparseMlpNetwork::getNumLayers() const
+{
+    return (int) this->layers.size();
+}
+
+/**
+ * getter for one of the network's layers (after folding, see MlpNetwork::getLayer())
+ * @param layer layer's index
+ * @return the layer
+ */
+const SparseDense &SparseMlpNetwork::getLayer(const int layer) const
+{
+    return this->layers[layer];
+}
+
+/**
+ * overloading operator "()" for SparseMlpNetwork object: returns a Digit object presents what digit is described
+ * on given matrix presenting an image and at what probability.
+ * @param img given matrix presents an image describing a digit
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit SparseMlpNetwork::operator()(const Matrix &img) const
+{
+    static thread_local MlpWorkspace workspace;
+    return (*this)(img, workspace);
+}
+
+/**
+ * overloading operator "()" for SparseMlpNetwork object with a caller provided workspace (see MlpNetwork).
+ * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit SparseMlpNetwork::operator()(const Matrix &img, MlpWorkspace &workspace) const
+{
+    return classifyWithPlan(plan, layers, img, workspace);
+}
+
+/**
+ * classifies a batch of images in one forward pass: every layer is one sparse times dense product over the
+ * whole batch.
+ * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> SparseMlpNetwork::classifyBatch(const Matrix &images) const
+{
+    return classifyBatchWithPlan(plan, layers, images);
+}
@@ -0,0 +1,91 @@
+// SparseMlpNetwork.h
+/**
+ * @file SparseMlpNetwork.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief SparseMlpNetwork object class - MlpNetwork running on magnitude pruned weights
+ */
+
+#ifndef SPARSEMLPNETWORK_H
+#define SPARSEMLPNETWORK_H
+
+#include "MlpNetwork.h"
+#include "SparseDense.h"
+
+/**
+ * class of SparseMlpNetwork object: any sequence of layers, planned and run as MlpNetwork runs it's layers (see
+ * NetworkPlan.h). every layer is a SparseDense keeping the weights whose magnitude is at least the layer's pruning
+ * threshold.
+ */
+class SparseMlpNetwork : public DigitClassifier
+{
+private:
+    std::vector<SparseDense> layers;
+    NetworkPlan plan;
+public:
+    /**
+     * constructor for SparseMlpNetwork object of the default topology: checks the given matrices' dimensions as
+     * MlpNetwork does and prunes the weights of every layer.
+     * @param weights array of MLP_SIZE matrices representing weights
+     * @param biases array of MLP_SIZE matrices representing biases
+     * @param thresholds array of MLP_SIZE pruning thresholds, one per layer (see SparseDense)
+     */
+    SparseMlpNetwork(Matrix weights[], Matrix biases[], const float thresholds[]);
+
+    /**
+     * constructor for SparseMlpNetwork object from any sequence of layers: plans them (see NetworkPlan::build()) and
+     * prunes the weights of every planned layer. exits with an error message if the layers' dimensions don't match,
+     * or if there isn't one threshold per planned layer.
+     * @param specs network's layers, in order
+     * @param thresholds pruning thresholds, one per layer the plan runs (after folding, see SparseDense)
+     */
+    SparseMlpNetwork(std::vector<LayerSpec> specs, const std::vector<float> &thresholds);
+
+    /**
+     * getter for the network's plan
+     * @return network's plan
+     */
+    const NetworkPlan &getPlan() const;
+
+    /**
+     * getter for the number of layers the network runs (after folding)
+     * @return number of layers
+     */
+    int getNumLayers() const;
+
+    /**
+     * getter for one of the network's layers (after folding, see MlpNetwork::getLayer())
+     * @param layer layer's index
+     * @return the layer
+     */
+    const SparseDense &getLayer(int layer) const;
+
+    /**
+     * overloading operator "()" for SparseMlpNetwork object: returns a Digit object presents what digit is described
+     * on given matrix presenting an image and at what probability.
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * overloading operator "()" for SparseMlpNetwork object with a caller provided workspace (see MlpNetwork).
+     * @param img given matrix presents an image describing a digit (as many values as the first layer's inputs)
+     * @param workspace workspace to hold the intermediate results
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img, MlpWorkspace &workspace) const;
+
+    /**
+     * classifies a batch of images in one forward pass: every layer is one sparse times dense product over the
+     * whole batch.
+     * @param images matrix with a row per input of the first layer, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    std::vector<Digit> classifyBatch(const Matrix &images) const override;
+};
+
+#endif //SPARSEMLPNETWORK_H
@@ -0,0 +1,153 @@
+// StaticDense.h
+/**
+ * @file StaticDense.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief StaticDense object class - Dense layer with compile time dimensions and activation
+ */
+
+#ifndef STATICDENSE_H
+#define STATICDENSE_H
+
+// ------------------------------ includes ------------------------------
+
+#include <cmath>
+#include "StaticMatrix.h"
+#include "Activation.h"
+
+/**
+ * class of StaticDense object: a Dense layer of Out outputs and In inputs whose weights and bias are StaticMatrix
+ * members, so the whole layer lives inside the object and apply() runs without any runtime dimension check.
+ * the weights are kept transposed (In x Out): apply() adds x[k] times the k'th row to all Out outputs at once, so the
+ * Out accumulators stay in registers and the inner loop vectorizes without reordering any sum.
+ * @tparam T value type
+ * @tparam Out number of outputs (rows of the weights matrix)
+ * @tparam In number of inputs (columns of the weights matrix)
+ * @tparam Act activation function activated on the outputs
+ */
+template<typename T, int Out, int In, ActivationType Act>
+class StaticDense
+{
+private:
+    StaticMatrix<T, In, Out> wTransposed;
+    StaticMatrix<T, Out, 1> bias;
+
+public:
+    /**
+     * constructor for StaticDense object: exits with an error message if the given matrices' dimensions are not
+     * Out x In and Out x 1.
+     * @param w given matrix represents weights
+     * @param bias given matrix (actually a vector) represents bias
+     */
+    StaticDense(const Matrix &w, const Matrix &bias) : bias(bias)
+    {
+        if (w.getRows() != Out || w.getCols() != In)
+        {
+            std::cerr << "Error: weights matrix has invalid rows or cols number" << std::endl;
+            exit(1);
+        }
+        for (int i = 0; i < Out; i++)
+        {
+            for (int k = 0; k < In; k++)
+            {
+                wTransposed(k, i) = (T) w(i, k);
+            }
+        }
+    }
+
+    /**
+     * returns the layer's weights matrix (Out x In)
+     * @return copy of the layer's weights
+     */
+    Matrix getWeights() const
+    {
+        Matrix matrixToReturn(Out, In, NoInit);
+        for (int i = 0; i < Out; i++)
+        {
+            for (int k = 0; k < In; k++)
+            {
+                matrixToReturn(i, k) = (float) wTransposed(k, i);
+            }
+        }
+        return matrixToReturn;
+    }
+
+    /**
+     * writes act(w * x + bias) into a caller provided buffer
+     * @param x input vector of In values
+     * @param out output buffer of Out values (must not overlap x)
+     */
+    void apply(const T *x, T *out) const
+    {
+        T acc[Out];
+        for (int i = 0; i < Out; i++)
+        {
+            acc[i] = bias[i];
+        }
+        for (int k = 0; k < In; k++)
+        {
+            const T xk = x[k];
+            const T *row = wTransposed.getData() + k * Out;
+            for (int i = 0; i < Out; i++)
+            {
+                acc[i] += row[i] * xk;
+            }
+        }
+        if constexpr (Act == Relu)
+        {
+            for (int i = 0; i < Out; i++)
+            {
+                out[i] = acc[i] > 0 ? acc[i] : 0;
+            }
+            return;
+        }
+        if constexpr (Act == Identity)
+        {
+            for (int i = 0; i < Out; i++)
+            {
+                out[i] = acc[i];
+            }
+            return;
+        }
+        T maxValue = acc[0];
+        for (int i = 1; i < Out; i++)
+        {
+            maxValue = acc[i] > maxValue ? acc[i] : maxValue;
+        }
+        T eSum = 0;
+        for (int i = 0; i < Out; i++)
+        {
+            out[i] = std::exp(acc[i] - maxValue);
+            eSum += out[i];
+        }
+        if constexpr (Act == LogSoftmax)
+        {
+            const T logSum = maxValue + std::log(eSum);
+            for (int i = 0; i < Out; i++)
+            {
+                out[i] = acc[i] - logSum;
+            }
+            return;
+        }
+        const T inverseSum = 1 / eSum;
+        for (int i = 0; i < Out; i++)
+        {
+            out[i] *= inverseSum;
+        }
+    }
+
+    /**
+     * overloading operator "()" for StaticDense object: returns act(w * x + bias)
+     * @param x input vector
+     * @return the layer's output vector
+     */
+    StaticMatrix<T, Out, 1> operator()(const StaticMatrix<T, In, 1> &x) const
+    {
+        StaticMatrix<T, Out, 1> vectorToReturn;
+        apply(x.getData(), vectorToReturn.getData());
+        return vectorToReturn;
+    }
+};
+
+#endif //STATICDENSE_H
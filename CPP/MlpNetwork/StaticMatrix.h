@@ -0,0 +1,229 @@
+// StaticMatrix.h
+/**
+ * @file StaticMatrix.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief StaticMatrix object class - matrix with compile time dimensions.
+ *
+ * @section DESCRIPTION
+ * a StaticMatrix<T, Rows, Cols> keeps it's Rows * Cols values inside the object (no heap buffer), and every operation
+ * is a template over the dimensions: mismatched dimensions don't compile instead of being checked at runtime, and
+ * every loop has a compile time trip count the compiler can unroll and vectorize. meant for small matrices, such as
+ * the tail layers of the network, that can live on the stack or in registers. the only runtime dimension check is
+ * when a StaticMatrix is built from a (dynamically sized) Matrix.
+ */
+
+#ifndef STATICMATRIX_H
+#define STATICMATRIX_H
+
+// ------------------------------ includes ------------------------------
+
+#include <cstdlib>
+#include <iostream>
+#include "Matrix.h"
+
+/**
+ * class of StaticMatrix object
+ * @tparam T value type
+ * @tparam Rows number of rows
+ * @tparam Cols number of columns
+ */
+template<typename T, int Rows, int Cols>
+class StaticMatrix
+{
+    static_assert(Rows > 0 && Cols > 0, "StaticMatrix dimensions must be positive");
+
+private:
+    T values[Rows * Cols];
+
+public:
+    /**
+     * constructor for StaticMatrix object, all values are 0
+     */
+    StaticMatrix() : values()
+    {
+    }
+
+    /**
+     * constructor for StaticMatrix object with the values of a given Matrix (converted to T). exits with an error
+     * message if m's dimensions are not Rows x Cols.
+     * @param m matrix to copy values from
+     */
+    explicit StaticMatrix(const Matrix &m)
+    {
+        if (m.getRows() != Rows || m.getCols() != Cols)
+        {
+            std::cerr << "Error: matrix has invalid rows or cols number" << std::endl;
+            exit(1);
+        }
+        for (int i = 0; i < Rows; i++)
+        {
+            for (int j = 0; j < Cols; j++)
+            {
+                values[i * Cols + j] = (T) m(i, j);
+            }
+        }
+    }
+
+    /**
+     * getter for matrix's number of rows
+     * @return matrix's number of rows
+     */
+    static constexpr int getRows()
+    {
+        return Rows;
+    }
+
+    /**
+     * getter for matrix's number of columns
+     * @return matrix's number of columns
+     */
+    static constexpr int getCols()
+    {
+        return Cols;
+    }
+
+    /**
+     * getter for matrix's values (Rows * Cols values stored row after row)
+     * @return pointer to the matrix's first value
+     */
+    T *getData()
+    {
+        return values;
+    }
+
+    /**
+     * getter for matrix's values (see getData()) as const
+     * @return const pointer to the matrix's first value
+     */
+    const T *getData() const
+    {
+        return values;
+    }
+
+    /**
+     * returns a Matrix with this matrix's values (converted to float)
+     * @return dynamically sized copy of this matrix
+     */
+    Matrix toMatrix() const
+    {
+        Matrix matrixToReturn(Rows, Cols, NoInit);
+        for (int i = 0; i < Rows * Cols; i++)
+        {
+            matrixToReturn[i] = (float) values[i];
+        }
+        return matrixToReturn;
+    }
+
+    /**
+     * overloading operator "()" for StaticMatrix object: returns reference to the value at index (i,j)
+     * @param i row index
+     * @param j column index
+     * @return reference to matrix's value at index (i,j)
+     */
+    T &operator()(int i, int j)
+    {
+        return values[i * Cols + j];
+    }
+
+    /**
+     * overloading operator "()" for StaticMatrix object: returns the value at index (i,j)
+     * @param i row index
+     * @param j column index
+     * @return matrix's value at index (i,j)
+     */
+    T operator()(int i, int j) const
+    {
+        return values[i * Cols + j];
+    }
+
+    /**
+     * overloading operator "[]" for StaticMatrix object: returns reference to the value at index i
+     * @param i value index in matrix's data
+     * @return reference to matrix's value at index i
+     */
+    T &operator[](int i)
+    {
+        return values[i];
+    }
+
+    /**
+     * overloading operator "[]" for StaticMatrix object: returns the value at index i
+     * @param i value index in matrix's data
+     * @return matrix's value at index i
+     */
+    T operator[](int i) const
+    {
+        return values[i];
+    }
+
+    /**
+     * overloading operator "+=" for StaticMatrix object: adds m's values to this matrix's values in place
+     * @param m matrix of the same dimensions to add
+     * @return reference to this matrix
+     */
+    StaticMatrix &operator+=(const StaticMatrix &m)
+    {
+        for (int i = 0; i < Rows * Cols; i++)
+        {
+            values[i] += m.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * overloading operator "*=" for StaticMatrix object: multiplies this matrix's values by a scalar in place
+     * @param scalar value to multiply matrix's values with
+     * @return reference to this matrix
+     */
+    StaticMatrix &operator*=(T scalar)
+    {
+        for (int i = 0; i < Rows * Cols; i++)
+        {
+            values[i] *= scalar;
+        }
+        return *this;
+    }
+};
+
+/**
+ * overloading operator "+" for StaticMatrix objects of the same dimensions
+ * @param a left operand
+ * @param b right operand
+ * @return a + b
+ */
+template<typename T, int Rows, int Cols>
+StaticMatrix<T, Rows, Cols> operator+(const StaticMatrix<T, Rows, Cols> &a, const StaticMatrix<T, Rows, Cols> &b)
+{
+    StaticMatrix<T, Rows, Cols> matrixToReturn(a);
+    matrixToReturn += b;
+    return matrixToReturn;
+}
+
+/**
+ * overloading operator "*" for StaticMatrix objects: matrix product. the inner dimensions are matched by the template
+ * arguments, so a product of mismatched matrices does not compile.
+ * @param a left operand (Rows x Inner)
+ * @param b right operand (Inner x Cols)
+ * @return a * b (Rows x Cols)
+ */
+template<typename T, int Rows, int Inner, int Cols>
+StaticMatrix<T, Rows, Cols> operator*(const StaticMatrix<T, Rows, Inner> &a, const StaticMatrix<T, Inner, Cols> &b)
+{
+    StaticMatrix<T, Rows, Cols> matrixToReturn;
+    for (int i = 0; i < Rows; i++)
+    {
+        for (int k = 0; k < Inner; k++)
+        {
+            const T aik = a(i, k);
+            for (int j = 0; j < Cols; j++)
+            {
+                matrixToReturn(i, j) += aik * b(k, j);
+            }
+        }
+    }
+    return matrixToReturn;
+}
+
+#endif //STATICMATRIX_H
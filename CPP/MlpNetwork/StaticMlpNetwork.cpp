@@ -0,0 +1,113 @@
+/**
+ * @file StaticMlpNetwork.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief StaticMlpNetwork object class - MlpNetwork specialized for it's fixed topology at compile time
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include "StaticMlpNetwork.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for StaticMlpNetwork object: checks the given matrices' dimensions as MlpNetwork does and builds the
+ * layers.
+ * @param weights array of matrices representing weights
+ * @param biases array of matrices representing biases
+ */
+StaticMlpNetwork::StaticMlpNetwork(Matrix weights[], Matrix biases[]) :
+        dense0(weights[0], biases[0], Relu), dense1(weights[1], biases[1], Relu),
+        dense2(weights[2], biases[2]), dense3(weights[3], biases[3])
+{
+    for (int i = 0; i < MLP_SIZE; i++)
+    {
+        checkLayerDims(i, weights[i], biases[i]);
+    }
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * runs the tail layers on the output of dense1
+ * @param hidden dense1's output vector
+ * @return Digit object with the most probable digit and it's probability
+ */
+Digit StaticMlpNetwork::classifyTail(const float *hidden) const
+{
+    float r3[weightsDims[2].rows];
+    float probs[weightsDims[3].rows];
+    dense2.apply(hidden, r3);
+    dense3.apply(r3, probs);
+    return mostProbableDigit(probs, weightsDims[3].rows, 1);
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * overloading operator "()" for StaticMlpNetwork object: returns a Digit object presents what digit is described on
+ * given matrix presenting an image and at what probability.
+ * @param img given matrix presents an image describing a digit
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit StaticMlpNetwork::operator()(const Matrix &img) const
+{
+    static thread_local MlpWorkspace workspace;
+    return (*this)(img, workspace);
+}
+
+/**
+ * overloading operator "()" for StaticMlpNetwork object with a caller provided workspace (see MlpNetwork). only the
+ * outputs of the two wide layers are written to the workspace.
+ * @param img given matrix presents an image describing a digit (784 values)
+ * @param workspace workspace to hold the intermediate results
+ * @return Digit object presents what digit is described on given matrix presenting an image and at what probability.
+ */
+Digit StaticMlpNetwork::operator()(const Matrix &img, MlpWorkspace &workspace) const
+{
+    if (img.getRows() * img.getCols() != imgDims.rows * imgDims.cols)
+    {
+        std::cerr << "Error: image has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    if (img.getLeadingDim() != img.getCols())
+    {
+        return (*this)(Matrix(img, PackedRows), workspace);
+    }
+    float *r1 = workspace.getBuffer(0, biasDims[0].rows), *r2 = workspace.getBuffer(1, biasDims[1].rows);
+    dense0.apply(img.getData(), r1);
+    dense1.apply(r1, r2);
+    return classifyTail(r2);
+}
+
+/**
+ * classifies a batch of images: the wide layers run as one matrix product over the whole batch (see
+ * MlpNetwork::classifyBatch), the tail layers run column by column.
+ * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+ * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+ */
+std::vector<Digit> StaticMlpNetwork::classifyBatch(const Matrix &images) const
+{
+    if (images.getRows() != imgDims.rows * imgDims.cols)
+    {
+        std::cerr << "Error: batch of images has invalid number of rows" << std::endl;
+        exit(1);
+    }
+    Matrix r1 = dense0(images);
+    r1 = dense1(r1);
+    const int batchSize = r1.getCols();
+    std::vector<Digit> digitsToReturn;
+    digitsToReturn.reserve(batchSize);
+    float hidden[weightsDims[1].rows];
+    for (int j = 0; j < batchSize; j++)
+    {
+        for (int i = 0; i < weightsDims[1].rows; i++)
+        {
+            hidden[i] = r1.getData()[(long) i * batchSize + j];
+        }
+        digitsToReturn.push_back(classifyTail(hidden));
+    }
+    return digitsToReturn;
+}
@@ -0,0 +1,78 @@
+// StaticMlpNetwork.h
+/**
+ * @file StaticMlpNetwork.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief StaticMlpNetwork object class - MlpNetwork specialized for it's fixed topology at compile time
+ */
+
+#ifndef STATICMLPNETWORK_H
+#define STATICMLPNETWORK_H
+
+#include "MlpNetwork.h"
+#include "StaticDense.h"
+
+/**
+ * class of StaticMlpNetwork object: same topology and results as MlpNetwork, with the two small tail layers
+ * (20x64 and 10x20) built as StaticDense layers from the constexpr topology. their weights live inside the network
+ * object, their loops have compile time trip counts, and their intermediate vectors live on the stack, so they run
+ * without any dimension check or call through the generic kernels. the two wide layers stay Dense layers, whose
+ * weights are too large for the stack and whose dot products use the widest instruction set the cpu supports.
+ */
+class StaticMlpNetwork : public DigitClassifier
+{
+private:
+    typedef StaticDense<float, weightsDims[2].rows, weightsDims[2].cols, Relu> TailDense2;
+    typedef StaticDense<float, weightsDims[3].rows, weightsDims[3].cols, Softmax> TailDense3;
+
+    Dense dense0;
+    Dense dense1;
+    TailDense2 dense2;
+    TailDense3 dense3;
+
+    /**
+     * runs the tail layers on the output of dense1
+     * @param hidden dense1's output vector
+     * @return Digit object with the most probable digit and it's probability
+     */
+    Digit classifyTail(const float *hidden) const;
+
+public:
+    /**
+     * constructor for StaticMlpNetwork object: checks the given matrices' dimensions as MlpNetwork does and builds
+     * the layers.
+     * @param weights array of matrices representing weights
+     * @param biases array of matrices representing biases
+     */
+    StaticMlpNetwork(Matrix weights[], Matrix biases[]);
+
+    /**
+     * overloading operator "()" for StaticMlpNetwork object: returns a Digit object presents what digit is described
+     * on given matrix presenting an image and at what probability.
+     * @param img given matrix presents an image describing a digit
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img) const override;
+
+    /**
+     * overloading operator "()" for StaticMlpNetwork object with a caller provided workspace (see MlpNetwork). only
+     * the outputs of the two wide layers are written to the workspace.
+     * @param img given matrix presents an image describing a digit (784 values)
+     * @param workspace workspace to hold the intermediate results
+     * @return Digit object presents what digit is described on given matrix presenting an image and at what
+     * probability.
+     */
+    Digit operator()(const Matrix &img, MlpWorkspace &workspace) const;
+
+    /**
+     * classifies a batch of images: the wide layers run as one matrix product over the whole batch (see
+     * MlpNetwork::classifyBatch), the tail layers run column by column.
+     * @param images matrix of 784 rows, each of it's columns is one image (vectorized)
+     * @return vector of Digit objects, the i'th Digit describes the image in the i'th column
+     */
+    std::vector<Digit> classifyBatch(const Matrix &images) const override;
+};
+
+#endif //STATICMLPNETWORK_H
@@ -0,0 +1,186 @@
+/**
+ * @file ThreadPool.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ThreadPool object class - fixed set of worker threads with per-worker task queues and work stealing
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <utility>
+#include "ThreadPool.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for ThreadPool object: starts the worker threads
+ * @param numThreads number of worker threads, 0 for one per hardware thread
+ */
+ThreadPool::ThreadPool(int numThreads) : queuedTasks(0), nextQueue(0), stopping(false)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < numThreads; i++)
+    {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i < numThreads; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * destructor for ThreadPool object: runs the tasks still queued and joins the worker threads
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * pops one task, from the back of the given worker's queue or else from the front of another queue, and runs it
+ * @param self index of the calling worker, or -1 for a thread outside the pool
+ * @return true if a task was run, false if every queue was empty
+ */
+bool ThreadPool::runOneTask(const int self)
+{
+    std::function<void()> task;
+    if (self >= 0)
+    {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (!queues[self]->tasks.empty())
+        {
+            task = std::move(queues[self]->tasks.back());
+            queues[self]->tasks.pop_back();
+        }
+    }
+    const int numQueues = (int) queues.size();
+    for (int i = 1; i <= numQueues && !task; i++)
+    {
+        WorkerQueue &victim = *queues[(std::max(self, 0) + i) % numQueues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task)
+    {
+        return false;
+    }
+    queuedTasks--;
+    task();
+    return true;
+}
+
+/**
+ * main loop of a worker thread: runs tasks and sleeps while there are none, until the pool is destroyed
+ * @param self index of the worker
+ */
+void ThreadPool::workerLoop(const int self)
+{
+    while (true)
+    {
+        if (runOneTask(self))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]
+        { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0)
+        {
+            return;
+        }
+    }
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the number of worker threads
+ * @return number of worker threads
+ */
+int ThreadPool::getNumThreads() const
+{
+    return (int) workers.size();
+}
+
+/**
+ * queues a task to run on one of the workers. tasks are spread over the workers' queues round robin.
+ * @param task task to run
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+    WorkerQueue &queue = *queues[nextQueue++ % queues.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks++;
+    }
+    wakeUp.notify_one();
+}
+
+/**
+ * runs body over [0, count) split into chunks of grain indices, and returns when every chunk is done. the calling
+ * thread runs chunks too while it waits, so parallelFor may be called from inside a task.
+ * @param count number of indices
+ * @param grain number of indices per chunk (at least 1)
+ * @param body function called with [begin, end) of one chunk
+ */
+void ThreadPool::parallelFor(const long count, long grain, const std::function<void(long begin, long end)> &body)
+{
+    grain = std::max(1L, grain);
+    const long numChunks = (count + grain - 1) / grain;
+    if (numChunks <= 1)
+    {
+        if (count > 0)
+        {
+            body(0, count);
+        }
+        return;
+    }
+    std::atomic<long> chunksLeft(numChunks);
+    std::mutex doneMutex;
+    std::condition_variable done;
+    for (long chunk = 0; chunk < numChunks; chunk++)
+    {
+        submit([&, chunk]
+               {
+                   body(chunk * grain, std::min(count, (chunk + 1) * grain));
+                   // decremented under the lock, so the waiter can't return (and destroy doneMutex) before
+                   // this task is done with it
+                   std::lock_guard<std::mutex> lock(doneMutex);
+                   if (--chunksLeft == 0)
+                   {
+                       done.notify_all();
+                   }
+               });
+    }
+    // every chunk is either still queued (run it here) or already taken by a worker (wait for it)
+    while (chunksLeft > 0 && runOneTask(-1))
+    {
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&chunksLeft]
+    { return chunksLeft == 0; });
+}
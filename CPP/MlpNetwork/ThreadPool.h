@@ -0,0 +1,99 @@
+// ThreadPool.h
+/**
+ * @file ThreadPool.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief ThreadPool object class - fixed set of worker threads with per-worker task queues and work stealing
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * class of ThreadPool object: every worker owns a task queue. a worker runs the newest task of it's own queue (the
+ * one most likely still in cache) and, when it's queue is empty, steals the oldest task of another worker's queue,
+ * so uneven tasks are balanced without a single contended queue.
+ */
+class ThreadPool
+{
+private:
+    /**
+     * @struct WorkerQueue
+     * @brief task queue of one worker, the owner pops at the back and thieves at the front
+     */
+    typedef struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    } WorkerQueue;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<long> queuedTasks;
+    std::atomic<unsigned int> nextQueue;
+    bool stopping;
+
+    /**
+     * pops one task, from the back of the given worker's queue or else from the front of another queue, and runs it
+     * @param self index of the calling worker, or -1 for a thread outside the pool
+     * @return true if a task was run, false if every queue was empty
+     */
+    bool runOneTask(int self);
+
+    /**
+     * main loop of a worker thread: runs tasks and sleeps while there are none, until the pool is destroyed
+     * @param self index of the worker
+     */
+    void workerLoop(int self);
+
+public:
+    /**
+     * constructor for ThreadPool object: starts the worker threads
+     * @param numThreads number of worker threads, 0 for one per hardware thread
+     */
+    explicit ThreadPool(int numThreads = 0);
+
+    /**
+     * destructor for ThreadPool object: runs the tasks still queued and joins the worker threads
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &other) = delete;
+
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+
+    /**
+     * getter for the number of worker threads
+     * @return number of worker threads
+     */
+    int getNumThreads() const;
+
+    /**
+     * queues a task to run on one of the workers. tasks are spread over the workers' queues round robin.
+     * @param task task to run
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * runs body over [0, count) split into chunks of grain indices, and returns when every chunk is done. the calling
+     * thread runs chunks too while it waits, so parallelFor may be called from inside a task.
+     * @param count number of indices
+     * @param grain number of indices per chunk (at least 1)
+     * @param body function called with [begin, end) of one chunk
+     */
+    void parallelFor(long count, long grain, const std::function<void(long begin, long end)> &body);
+};
+
+#endif //THREADPOOL_H
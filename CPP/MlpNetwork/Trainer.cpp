@@ -0,0 +1,227 @@
+/**
+ * @file Trainer.cpp
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief Trainer object class - mini-batch training of a sequence of Dense layers with backpropagation
+ */
+
+// ------------------------------ includes ------------------------------
+
+#include <algorithm>
+#include <utility>
+#include "Trainer.h"
+#include "ModelBundle.h"
+#include "SimdKernels.h"
+
+// ------------------------------ constructors -----------------------------
+
+/**
+ * constructor for Trainer object: copies the given layers (so they can be updated). exits with an error message
+ * if the layers don't form a network or the last one isn't a Softmax or LogSoftmax.
+ * @param layers network's initial layers, in order
+ * @param optimizer optimizer computing the steps of the parameters (must outlive the Trainer)
+ * @param numThreads number of threads, 0 for one per hardware thread
+ */
+Trainer::Trainer(const std::vector<LayerSpec> &layers, Optimizer &optimizer, const int numThreads) :
+        optimizer(optimizer), pool(numThreads), shards(pool.getNumThreads())
+{
+    std::vector<LayerSpec> checkedLayers = layers;
+    NetworkPlan::build(checkedLayers);
+    const ActivationType lastActivation = layers.empty() ? Identity : layers.back().activation;
+    if (lastActivation != Softmax && lastActivation != LogSoftmax)
+    {
+        std::cerr << "Error: the last layer of a trained network must be a softmax" << std::endl;
+        exit(1);
+    }
+    this->layers.reserve(layers.size());
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        // the last layer outputs logits, it's softmax is fused with the loss
+        this->layers.emplace_back(layers[i].weights, layers[i].bias,
+                                  i + 1 == layers.size() ? Identity : layers[i].activation);
+        this->activations.push_back(layers[i].activation);
+    }
+    for (ShardState &shard : shards)
+    {
+        shard.outputs.resize(layers.size());
+        shard.weightsGradients.resize(layers.size());
+        shard.biasGradients.resize(layers.size());
+    }
+}
+
+// ------------------------------ private functions - not part of the API -----------------------------
+
+/**
+ * runs the forward pass (and the backward pass, when training) of one shard
+ * @param shard shard's buffers
+ * @param images the whole mini-batch
+ * @param labels labels of the whole mini-batch
+ * @param begin first column of the shard
+ * @param end one past the last column of the shard
+ * @param train whether to run the backward pass
+ */
+void Trainer::runShard(ShardState &shard, const Matrix &images, const int *labels, const int begin, const int end,
+                       const bool train) const
+{
+    const int rows = images.getRows(), columns = end - begin;
+    if (shard.input.getRows() != rows || shard.input.getCols() != columns)
+    {
+        shard.input = Matrix(rows, columns, NoInit);
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        const float *imagesRow = images.getData() + (long) i * images.getLeadingDim() + begin;
+        std::copy(imagesRow, imagesRow + columns, shard.input.getData() + (long) i * columns);
+    }
+    const int numLayers = (int) layers.size();
+    for (int l = 0; l < numLayers; l++)
+    {
+        shard.outputs[l] = layers[l](l == 0 ? shard.input : shard.outputs[l - 1]);
+    }
+    shard.gradient = shard.outputs[numLayers - 1];
+    shard.result.loss = softmaxCrossEntropy(shard.gradient.getData(), labels + begin, shard.gradient.getRows(),
+                                            columns, shard.result.correct);
+    if (!train)
+    {
+        return;
+    }
+    for (int l = numLayers - 1; l >= 0; l--)
+    {
+        layers[l].backward(l == 0 ? shard.input : shard.outputs[l - 1], shard.outputs[l], shard.gradient,
+                           shard.weightsGradients[l], shard.biasGradients[l], l == 0 ? nullptr : &shard.inputGradient);
+        std::swap(shard.gradient, shard.inputGradient);
+    }
+}
+
+/**
+ * runs a mini-batch on every shard, in parallel. every label must be the index of one of the last layer's rows.
+ * @param images the mini-batch
+ * @param labels labels of the mini-batch
+ * @param train whether to run the backward passes
+ * @return number of shards used
+ */
+int Trainer::runShards(const Matrix &images, const int *labels, const bool train)
+{
+    const int batchSize = images.getCols();
+    if (images.getRows() != layers.front().getWeights().getCols() || batchSize == 0)
+    {
+        std::cerr << "Error: training batch has invalid rows or cols number" << std::endl;
+        exit(1);
+    }
+    const int outputRows = layers.back().getWeights().getRows();
+    for (int j = 0; j < batchSize; j++)
+    {
+        if (labels[j] < 0 || labels[j] >= outputRows)
+        {
+            std::cerr << "Error: training batch has an invalid label" << std::endl;
+            exit(1);
+        }
+    }
+    const int numShards = std::max(1, std::min((int) shards.size(), batchSize / MIN_SHARD_COLUMNS));
+    pool.parallelFor(numShards, 1, [&](const long first, const long last)
+    {
+        for (long s = first; s < last; s++)
+        {
+            runShard(shards[s], images, labels, (int) (s * batchSize / numShards),
+                     (int) ((s + 1) * batchSize / numShards), train);
+        }
+    });
+    return numShards;
+}
+
+// ------------------------------ public functions - part of the API -----------------------------
+
+/**
+ * getter for the number of threads the mini-batches are split over
+ * @return number of threads
+ */
+int Trainer::getNumThreads() const
+{
+    return pool.getNumThreads();
+}
+
+/**
+ * trains the network on one mini-batch: runs the forward and backward passes and updates every layer by the
+ * optimizer's steps for the gradients of the mini-batch's mean loss.
+ * @param images mini-batch, each of it's columns is one input vector
+ * @param labels label of every column
+ * @return the mini-batch's mean loss and number of correctly classified vectors (before the update)
+ */
+BatchResult Trainer::trainBatch(const Matrix &images, const int *labels)
+{
+    const int numShards = runShards(images, labels, true);
+    const SimdKernelTable &kernels = simdKernels();
+    ShardState &total = shards[0];
+    for (int s = 1; s < numShards; s++)
+    {
+        total.result.loss += shards[s].result.loss;
+        total.result.correct += shards[s].result.correct;
+        for (size_t l = 0; l < layers.size(); l++)
+        {
+            Matrix &weightsGradient = total.weightsGradients[l], &biasGradient = total.biasGradients[l];
+            kernels.add(weightsGradient.getData(), shards[s].weightsGradients[l].getData(), weightsGradient.getData(),
+                        (long) weightsGradient.getRows() * weightsGradient.getCols());
+            kernels.add(biasGradient.getData(), shards[s].biasGradients[l].getData(), biasGradient.getData(),
+                        biasGradient.getRows());
+        }
+    }
+    const float inverseBatchSize = 1.0f / (float) images.getCols();
+    for (size_t l = 0; l < layers.size(); l++)
+    {
+        total.weightsGradients[l] *= inverseBatchSize;
+        total.biasGradients[l] *= inverseBatchSize;
+        optimizer.computeStep((int) (2 * l), total.weightsGradients[l], weightsStep);
+        optimizer.computeStep((int) (2 * l + 1), total.biasGradients[l], biasStep);
+        layers[l].update(weightsStep, biasStep);
+    }
+    return {total.result.loss * inverseBatchSize, total.result.correct};
+}
+
+/**
+ * runs the network on a batch without training it
+ * @param images batch, each of it's columns is one input vector
+ * @param labels label of every column
+ * @return the batch's mean loss and number of correctly classified vectors
+ */
+BatchResult Trainer::evaluate(const Matrix &images, const int *labels)
+{
+    const int numShards = runShards(images, labels, false);
+    BatchResult result = {0, 0};
+    for (int s = 0; s < numShards; s++)
+    {
+        result.loss += shards[s].result.loss;
+        result.correct += shards[s].result.correct;
+    }
+    result.loss /= (float) images.getCols();
+    return result;
+}
+
+/**
+ * returns the network's current layers, with the activations the network was given
+ * @return network's layers
+ */
+std::vector<LayerSpec> Trainer::getLayers() const
+{
+    std::vector<LayerSpec> layersToReturn;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        layersToReturn.push_back({Matrix(layers[i].getWeights(), PackedRows), layers[i].getBias(), activations[i]});
+    }
+    return layersToReturn;
+}
+
+/**
+ * writes the network's current layers to a model bundle file (see ModelBundle)
+ * @param bundlePath path of the bundle file to write
+ */
+void Trainer::writeBundle(const std::string &bundlePath) const
+{
+    std::vector<Matrix> weights, biases;
+    for (const LayerSpec &layer : getLayers())
+    {
+        weights.push_back(layer.weights);
+        biases.push_back(layer.bias);
+    }
+    ModelBundle::write(bundlePath, weights.data(), biases.data(), (int) weights.size(), activations.data());
+}
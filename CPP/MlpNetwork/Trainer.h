@@ -0,0 +1,133 @@
+// Trainer.h
+/**
+ * @file Trainer.h
+ * @author  Omer Salman <omer.salman@mail.huji.ac.il>
+ * @date 16 Oct 2026
+ *
+ * @brief Trainer object class - mini-batch training of a sequence of Dense layers with backpropagation
+ */
+
+#ifndef TRAINER_H
+#define TRAINER_H
+
+#include <string>
+#include <vector>
+#include "Dense.h"
+#include "NetworkPlan.h"
+#include "Optimizer.h"
+#include "ThreadPool.h"
+
+/**
+ * @def MIN_SHARD_COLUMNS
+ * @brief smallest number of a mini-batch's vectors a thread is given, so the shards' matrix products stay efficient
+ */
+#define MIN_SHARD_COLUMNS 16
+
+/**
+ * @struct BatchResult
+ * @brief result of running a mini-batch: it's mean cross-entropy loss and the number of correctly classified vectors
+ */
+typedef struct BatchResult
+{
+    float loss;
+    int correct;
+} BatchResult;
+
+/**
+ * class of Trainer object: trains a network whose last layer is a Softmax (or LogSoftmax) with the cross-entropy
+ * loss. every mini-batch is split column-wise into one shard per thread, every thread runs the forward and
+ * backward passes of it's shard as batched matrix products, and the shards' gradients are summed before the
+ * optimizer updates the layers (data parallel training - the result doesn't depend on the number of threads, up to
+ * rounding).
+ */
+class Trainer
+{
+private:
+    /**
+     * @struct ShardState
+     * @brief buffers of one shard: it's input, the outputs of every layer and the gradients of every layer
+     */
+    typedef struct ShardState
+    {
+        Matrix input;
+        std::vector<Matrix> outputs;
+        std::vector<Matrix> weightsGradients;
+        std::vector<Matrix> biasGradients;
+        Matrix gradient, inputGradient;
+        BatchResult result;
+    } ShardState;
+
+    std::vector<Dense> layers;
+    std::vector<ActivationType> activations;
+    Optimizer &optimizer;
+    ThreadPool pool;
+    std::vector<ShardState> shards;
+    Matrix weightsStep, biasStep;
+
+    /**
+     * runs the forward pass (and the backward pass, when training) of one shard
+     * @param shard shard's buffers
+     * @param images the whole mini-batch
+     * @param labels labels of the whole mini-batch
+     * @param begin first column of the shard
+     * @param end one past the last column of the shard
+     * @param train whether to run the backward pass
+     */
+    void runShard(ShardState &shard, const Matrix &images, const int *labels, int begin, int end, bool train) const;
+
+    /**
+     * runs a mini-batch on every shard, in parallel. every label must be the index of one of the last layer's rows.
+     * @param images the mini-batch
+     * @param labels labels of the mini-batch
+     * @param train whether to run the backward passes
+     * @return number of shards used
+     */
+    int runShards(const Matrix &images, const int *labels, bool train);
+
+public:
+    /**
+     * constructor for Trainer object: copies the given layers (so they can be updated). exits with an error message
+     * if the layers don't form a network or the last one isn't a Softmax or LogSoftmax.
+     * @param layers network's initial layers, in order
+     * @param optimizer optimizer computing the steps of the parameters (must outlive the Trainer)
+     * @param numThreads number of threads, 0 for one per hardware thread
+     */
+    Trainer(const std::vector<LayerSpec> &layers, Optimizer &optimizer, int numThreads = 0);
+
+    /**
+     * getter for the number of threads the mini-batches are split over
+     * @return number of threads
+     */
+    int getNumThreads() const;
+
+    /**
+     * trains the network on one mini-batch: runs the forward and backward passes and updates every layer by the
+     * optimizer's steps for the gradients of the mini-batch's mean loss.
+     * @param images mini-batch, each of it's columns is one input vector
+     * @param labels label of every column
+     * @return the mini-batch's mean loss and number of correctly classified vectors (before the update)
+     */
+    BatchResult trainBatch(const Matrix &images, const int *labels);
+
+    /**
+     * runs the network on a batch without training it
+     * @param images batch, each of it's columns is one input vector
+     * @param labels label of every column
+     * @return the batch's mean loss and number of correctly classified vectors
+     */
+    BatchResult evaluate(const Matrix &images, const int *labels);
+
+    /**
+     * returns the network's current layers, with the activations the network was given
+     * @return network's layers
+     */
+    std::vector<LayerSpec> getLayers() const;
+
+    /**
+     * writes the network's current layers to a model bundle file (see ModelBundle)
+     * @param bundlePath path of the bundle file to write
+     */
+    void writeBundle(const std::string &bundlePath) const;
+};
+
+#endif //TRAINER_H